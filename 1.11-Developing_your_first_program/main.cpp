@@ -16,17 +16,23 @@ AUTHOR'S NOTE
 + You may be thinking, "C++ has so many rules and concepts. How do I remember all of this stuff?". Short answer: You don't. C++ is one part using what you know, and two parts looking up how to do the rest.
 + As you read through this site for the first time, focus less on memorizing specifics, and more on understanding what's possible. Then, when you have a need to implement something in a program you're writing, you can come back here (or to a reference site) and refresh yourself on how to do so.
 */
-#include <iostream>
+#include "bigInteger.h"
+#include "inputReader.h"
+#include "outputWriter.h"
+#include "scale.h"
 
 int main()
 {
-    std::cout << "Enter an integer: ";
+    OutputWriter& out{ standardOutput() };
+
+    out << "Enter an integer: ";
     
-    int number{};
-    std::cin >> number;
+    // A BigInteger instead of an int, so that doubling 2000000000 gives 4000000000 instead of overflowing.
+    BigInteger number{};
+    standardInput() >> number;
 
-    std::cout << "Double of " << number << " is " << number * 2 << '\n';
-    std::cout << "Triple of " << number << " is " << number * 3 << '\n';
+    out << "Double of " << number << " is " << arithmetic::scale<2>(number) << '\n';
+    out << "Triple of " << number << " is " << arithmetic::scale<3>(number) << '\n';
 
     return 0;
 }
\ No newline at end of file
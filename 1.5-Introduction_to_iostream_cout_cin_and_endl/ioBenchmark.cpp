@@ -0,0 +1,341 @@
+// Measures the claims from main.cpp on the machine at hand:
+//     + std::endl is slower than '\n', because it flushes the output buffer on every line.
+//     + std::cout is buffered, and the cost of output depends on where it goes: a terminal, a pipe or a file.
+//     + std::cin is tied to std::cout (std::cout is flushed before every extraction), and both are synchronized with C stdio by default.
+// It also compares ways of reading integers: operator>>, scanf and std::from_chars.
+// Every case runs in its own child process, because std::ios_base::sync_with_stdio() has to be called before any other I/O, and so that one case's settings never leak into the next.
+// Usage: ioBenchmark.out [count]    (count is the number of lines written/read per case, 1000000 by default)
+// POSIX only (fork, pipe, dup2).
+
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace
+{
+    enum class Target
+    {
+        terminal,
+        pipe,
+        file,
+    };
+
+    const char* targetName(Target target)
+    {
+        switch (target)
+        {
+        case Target::terminal:
+            return "terminal";
+        case Target::pipe:
+            return "pipe";
+        case Target::file:
+            return "file";
+        }
+        return "?";
+    }
+
+    // Each case does count operations with its own settings. Only that is timed: the bytes moved are counted by the parent.
+    using CaseFunction = void (*)(int count);
+
+    struct Case
+    {
+        const char* name;
+        CaseFunction run;
+        bool isInput;
+        int linesMoved; // Per operation: 1, or 2 for the echo cases, which read a line and write it back.
+    };
+
+    // Keeps the optimizer from dropping reads whose values are never used.
+    volatile long long consumed{};
+
+    // The bytes in the lines "0\n" to "count - 1\n".
+    std::uint64_t lineBytes(int count)
+    {
+        std::uint64_t bytes{ 0 };
+        char digits[16]{};
+        for (int i{ 0 }; i < count; ++i)
+            bytes += static_cast<std::uint64_t>(std::to_chars(digits, digits + sizeof(digits), i).ptr - digits) + 1;
+
+        return bytes;
+    }
+
+    // Output cases: write the numbers 0 to count - 1, one per line, to standard output.
+
+    void writeEndl(int count)
+    {
+        for (int i{ 0 }; i < count; ++i)
+            std::cout << i << std::endl;
+    }
+
+    void writeNewline(int count)
+    {
+        for (int i{ 0 }; i < count; ++i)
+            std::cout << i << '\n';
+
+        std::cout.flush();
+    }
+
+    void writeNewlineUnsynced(int count)
+    {
+        std::ios_base::sync_with_stdio(false);
+        writeNewline(count);
+    }
+
+    void writePrintf(int count)
+    {
+        for (int i{ 0 }; i < count; ++i)
+            std::printf("%d\n", i);
+
+        std::fflush(stdout);
+    }
+
+    // Input cases: read count integers from standard input (a file of numbers).
+
+    void readExtraction(int count)
+    {
+        long long sum{ 0 };
+        int value{};
+        for (int i{ 0 }; i < count && std::cin >> value; ++i)
+            sum += value;
+
+        consumed = sum;
+    }
+
+    void readExtractionUnsynced(int count)
+    {
+        std::ios_base::sync_with_stdio(false);
+        readExtraction(count);
+    }
+
+    void readScanf(int count)
+    {
+        long long sum{ 0 };
+        int value{};
+        for (int i{ 0 }; i < count && std::scanf("%d", &value) == 1; ++i)
+            sum += value;
+
+        consumed = sum;
+    }
+
+    void readFromChars(int count)
+    {
+        // Read everything in large blocks, then convert straight from the buffer.
+        std::vector<char> text{};
+        std::vector<char> block(1 << 16);
+        for (long long received{}; (received = read(STDIN_FILENO, block.data(), block.size())) > 0;)
+            text.insert(text.end(), block.data(), block.data() + received);
+
+        long long sum{ 0 };
+        const char* position{ text.data() };
+        const char* end{ text.data() + text.size() };
+        for (int i{ 0 }; i < count && position < end; ++i)
+        {
+            int value{};
+            position = std::from_chars(position, end, value).ptr + 1;
+            sum += value;
+        }
+
+        consumed = sum;
+    }
+
+    // Tied vs untied: read a number, then print it, like the lesson programs do. While tied, every extraction first flushes std::cout.
+    void echoTied(int count)
+    {
+        std::ios_base::sync_with_stdio(false);
+
+        int value{};
+        for (int i{ 0 }; i < count && std::cin >> value; ++i)
+            std::cout << value << '\n';
+
+        std::cout.flush();
+    }
+
+    void echoUntied(int count)
+    {
+        std::cin.tie(nullptr);
+        echoTied(count);
+    }
+
+    constexpr Case outputCases[]{
+        { "cout << i << std::endl", writeEndl, false, 1 },
+        { "cout << i << '\\n'", writeNewline, false, 1 },
+        { "cout << i << '\\n' (unsynced)", writeNewlineUnsynced, false, 1 },
+        { "printf(\"%d\\n\", i)", writePrintf, false, 1 },
+    };
+
+    constexpr Case inputCases[]{
+        { "cin >> i", readExtraction, true, 1 },
+        { "cin >> i (unsynced)", readExtractionUnsynced, true, 1 },
+        { "scanf(\"%d\", &i)", readScanf, true, 1 },
+        { "read() + std::from_chars", readFromChars, true, 1 },
+        { "cin >> i; cout << i (tied)", echoTied, true, 2 },
+        { "cin >> i; cout << i (untied)", echoUntied, true, 2 },
+    };
+
+    const std::string inputPath{ "ioBenchmark_input.txt" };
+    const std::string outputPath{ "ioBenchmark_output.txt" };
+
+    // Runs one case in a child process whose standard output goes to target (and standard input comes from the input file).
+    // Returns false if the target is not available (e.g. there is no terminal).
+    bool runInChild(const Case& benchmarkCase, Target target, int count, double& seconds)
+    {
+        int targetFd{ -1 };
+        int drainFd{ -1 };
+
+        if (target == Target::terminal)
+        {
+            targetFd = open("/dev/tty", O_WRONLY);
+            if (targetFd < 0)
+                return false;
+        }
+        else if (target == Target::file)
+        {
+            targetFd = open(outputPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (targetFd < 0)
+                return false;
+        }
+        else
+        {
+            int ends[2]{};
+            if (pipe(ends) != 0)
+                return false;
+            drainFd = ends[0];
+            targetFd = ends[1];
+        }
+
+        int resultPipe[2]{};
+        if (pipe(resultPipe) != 0)
+        {
+            close(targetFd);
+            if (drainFd >= 0)
+                close(drainFd);
+            return false;
+        }
+
+        // Anything still buffered in the parent would otherwise be written twice.
+        std::cout.flush();
+        std::fflush(stdout);
+
+        pid_t child{ fork() };
+        if (child == 0)
+        {
+            close(resultPipe[0]);
+            if (drainFd >= 0)
+                close(drainFd);
+
+            dup2(targetFd, STDOUT_FILENO);
+            close(targetFd);
+
+            if (benchmarkCase.isInput)
+            {
+                int inputFd{ open(inputPath.c_str(), O_RDONLY) };
+                if (inputFd < 0)
+                    _exit(1);
+                dup2(inputFd, STDIN_FILENO);
+                close(inputFd);
+            }
+
+            auto start{ std::chrono::steady_clock::now() };
+            benchmarkCase.run(count);
+            std::chrono::duration<double> elapsed{ std::chrono::steady_clock::now() - start };
+
+            double result{ elapsed.count() };
+            ssize_t written{ write(resultPipe[1], &result, sizeof(result)) };
+            _exit(written == static_cast<ssize_t>(sizeof(result)) ? 0 : 1);
+        }
+
+        close(resultPipe[1]);
+        close(targetFd);
+
+        // A pipe only keeps flowing if somebody reads the other end.
+        std::thread drainer{};
+        if (drainFd >= 0)
+        {
+            drainer = std::thread{ [drainFd]
+            {
+                std::vector<char> sink(1 << 16);
+                while (read(drainFd, sink.data(), sink.size()) > 0)
+                {
+                }
+                close(drainFd);
+            } };
+        }
+
+        ssize_t received{ read(resultPipe[0], &seconds, sizeof(seconds)) };
+        close(resultPipe[0]);
+
+        int status{};
+        waitpid(child, &status, 0);
+        if (drainer.joinable())
+            drainer.join();
+
+        return received == static_cast<ssize_t>(sizeof(seconds));
+    }
+
+    void report(const Case& benchmarkCase, Target target, int count, double seconds, std::uint64_t bytes)
+    {
+        double nanosecondsPerOperation{ seconds * 1e9 / count };
+        double megabytesPerSecond{ static_cast<double>(bytes) / seconds / 1e6 };
+
+        std::cout << "  " << std::left << std::setw(32) << benchmarkCase.name << std::setw(10) << targetName(target) << std::right << std::fixed
+                  << std::setprecision(1) << std::setw(10) << nanosecondsPerOperation << " ns/op" << std::setw(10) << megabytesPerSecond << " MB/s\n";
+    }
+
+    void writeInputFile(int count)
+    {
+        std::FILE* file{ std::fopen(inputPath.c_str(), "w") };
+        for (int i{ 0 }; i < count; ++i)
+            std::fprintf(file, "%d\n", i);
+        std::fclose(file);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    int count{ argc > 1 ? std::atoi(argv[1]) : 1000000 };
+    if (count <= 0)
+    {
+        std::cerr << "Usage: " << argv[0] << " [count]\n";
+        return 2;
+    }
+
+    const std::uint64_t bytes{ lineBytes(count) };
+
+    std::cout << "Output: " << count << " lines per case\n";
+    for (Target target : { Target::terminal, Target::pipe, Target::file })
+    {
+        for (const Case& benchmarkCase : outputCases)
+        {
+            double seconds{};
+            if (runInChild(benchmarkCase, target, count, seconds))
+                report(benchmarkCase, target, count, seconds, bytes * benchmarkCase.linesMoved);
+            else
+                std::cout << "  " << std::left << std::setw(32) << benchmarkCase.name << std::setw(10) << targetName(target) << "skipped (not available)\n";
+        }
+    }
+
+    writeInputFile(count);
+
+    std::cout << "Input: " << count << " integers per case, read from a file (echo cases write to a file)\n";
+    for (const Case& benchmarkCase : inputCases)
+    {
+        double seconds{};
+        if (runInChild(benchmarkCase, Target::file, count, seconds))
+            report(benchmarkCase, Target::file, count, seconds, bytes * benchmarkCase.linesMoved);
+    }
+
+    std::remove(inputPath.c_str());
+    std::remove(outputPath.c_str());
+    return 0;
+}
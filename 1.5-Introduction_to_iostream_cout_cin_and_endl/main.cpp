@@ -144,6 +144,7 @@ int main()
 
     d. A really big number (at lease 3 billion)
     → Result: You are most likely to get the number 2,147,483,647 (without the comma ,). x can only hold numbers up to a certain size. If you enter a value larger than the largest number x can hold, it will be set to the largest number that x can hold (which probably 2,147,483,647 but might be different on your system).
+    → When the number has to stay whole, extract it into a BigInteger instead (bigInteger.h in 2.8-Programs_with_multiple_code_files): it grows to as many digits as it is given. Try: echo 3000000000 4000000000 | main.out --big
 
     e. A small number followed by some letters, such as 123abc.
     → Result: The numeric values are printed (e.g. 123). 123 is extracted, the remaining characters (e.g. abc) are left for a later extraction.
@@ -13,7 +13,7 @@ KEYWORDS
     if inline int 
     long
     mutable
-    namespace new noexpect not not_eq nullptr
+    namespace new noexcept not not_eq nullptr
     operator or or_eq
     private protected public 
     register reinterpret_cast requires return
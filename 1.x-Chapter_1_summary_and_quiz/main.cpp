@@ -43,24 +43,44 @@ QUIZ TIME
     → Undefined behavior occurs when the programmer does something that is ill-specified by the C++ language. The consequences could be almost anything, from crashing to producing the wrong answer to working correctly anyway.
 + Question 3: Write a program that asks the user to enter a number, and then enter a second number. The program should tell the user what the result of adding and subtracting the two numbers is.
 */
-#include <iostream>
+#include <cstdint>
+#include <cstring>
 
-int main()
+#include "fixedWidthArithmetic.h"
+#include "inputReader.h"
+#include "mappedInput.h"
+#include "outputWriter.h"
+
+// One output line of the file mode: the sum and the difference of the pair. They wrap around instead of overflowing.
+void writeSumAndDifference(int first, int second, OutputWriter& out)
+{
+    out << arithmetic::add<arithmetic::Wrap, std::int32_t>(first, second) << ' ' << arithmetic::sub<arithmetic::Wrap, std::int32_t>(first, second) << '\n';
+}
+
+int main(int argc, char* argv[])
 {
-    std::cout << "Enter first number: ";
+    // main.out --file <path> reads pairs of numbers from a (possibly huge) file instead of asking for them.
+    if (argc == 3 && std::strcmp(argv[1], "--file") == 0)
+        return processPairFile(argv[2], writeSumAndDifference, standardOutput()) ? 0 : 1;
+
+    // standardOutput() only flushes when its buffer is full, when the program waits for input, or at exit.
+    OutputWriter& out{ standardOutput() };
+
+    out << "Enter first number: ";
 
     int first{};
-    std::cin >> first;
-    std::cout << '\n';
+    standardInput() >> first;
+    out << '\n';
 
-    std::cout << "Enter second number: ";
+    out << "Enter second number: ";
     
     int second{};
-    std::cin >> second;
-    std:: cout << '\n';
+    standardInput() >> second;
+    out << '\n';
 
-    std::cout << first << " + " << second << " is " << first + second << ".\n";
-    std::cout << first << " - " << second << " is " << first - second << ".\n";
+    // Wrapped like the file mode's, so that 2147483647 + 1 is -2147483648 here too instead of undefined behavior.
+    out << first << " + " << second << " is " << arithmetic::add<arithmetic::Wrap, std::int32_t>(first, second) << ".\n";
+    out << first << " - " << second << " is " << arithmetic::sub<arithmetic::Wrap, std::int32_t>(first, second) << ".\n";
 
     return 0;
 }
\ No newline at end of file
@@ -35,22 +35,34 @@ QUIZ TIME
 + Question 2: Write a complete program that reads an integer from the user, doubles it using the doubleNumber function you wrote in the previous question, and then prints the doubled value out to the console.
 */
 
-#include <iostream>
+#include "bigInteger.h"
+#include "inputReader.h"
+#include "outputWriter.h"
+#include "scale.h"
 
+// value * 2, which the compiler does as a shift or an add (see scale.h). Wraps around instead of overflowing.
 int doubleNumber(int value)
 {
-    return value * 2;
+    return arithmetic::scale<2>(value);
+}
+
+// The same for a number of any size: a one-bit shift, in one pass over the number.
+BigInteger doubleNumber(const BigInteger& value)
+{
+    return arithmetic::scale<2>(value);
 }
 
 int main()
 {
-    std::cout << "Enter your number: ";
+    OutputWriter& out{ standardOutput() };
+
+    out << "Enter your number: ";
 
-    int num{};
-    std::cin >> num;
-    std::cout << '\n';
+    BigInteger num{};
+    standardInput() >> num;
+    out << '\n';
 
-    std::cout << "Doubled value of your number: " << doubleNumber(num) << '\n';
+    out << "Doubled value of your number: " << doubleNumber(num) << '\n';
 
     return 0;
 }
\ No newline at end of file
@@ -1,4 +1,140 @@
+#include "add.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include "bigInteger.h"
+#include "fixedWidthArithmetic.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ADD_HAS_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+// Wraps on overflow (instead of undefined behavior), so a single add agrees with every array kernel below.
 int add(int x, int y)
+{
+    return arithmetic::add<arithmetic::Wrap>(x, y);
+}
+
+BigInteger add(const BigInteger& x, const BigInteger& y)
 {
     return x + y;
-}
\ No newline at end of file
+}
+
+namespace
+{
+    using AddArrayFunction = void (*)(const std::int32_t*, const std::int32_t*, std::int32_t*, std::size_t);
+
+    struct AddImplementation
+    {
+        AddArrayFunction function;
+        const char* name;
+    };
+
+    // Wrapping gives the same result as the SIMD instructions, without signed overflow being undefined behavior.
+    std::int32_t addWrapping(std::int32_t x, std::int32_t y)
+    {
+        return arithmetic::add<arithmetic::Wrap>(x, y);
+    }
+
+    void addScalar(const std::int32_t* a, const std::int32_t* b, std::int32_t* out, std::size_t count)
+    {
+        arithmetic::add<arithmetic::Wrap>(a, b, out, count);
+    }
+
+#ifdef ADD_HAS_X86_KERNELS
+    // Each kernel is compiled for its own instruction set via the target attribute, so the rest of the program still runs on any x86 CPU.
+    __attribute__((target("sse4.2")))
+    void addSse42(const std::int32_t* a, const std::int32_t* b, std::int32_t* out, std::size_t count)
+    {
+        std::size_t i{ 0 };
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i x{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)) };
+            __m128i y{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)) };
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_add_epi32(x, y));
+        }
+
+        for (; i < count; ++i)
+            out[i] = addWrapping(a[i], b[i]);
+    }
+
+    __attribute__((target("avx2")))
+    void addAvx2(const std::int32_t* a, const std::int32_t* b, std::int32_t* out, std::size_t count)
+    {
+        std::size_t i{ 0 };
+        for (; i + 16 <= count; i += 16)
+        {
+            __m256i x0{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)) };
+            __m256i y0{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)) };
+            __m256i x1{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i + 8)) };
+            __m256i y1{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i + 8)) };
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_add_epi32(x0, y0));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i + 8), _mm256_add_epi32(x1, y1));
+        }
+
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256i x{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)) };
+            __m256i y{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)) };
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_add_epi32(x, y));
+        }
+
+        for (; i < count; ++i)
+            out[i] = addWrapping(a[i], b[i]);
+    }
+
+    __attribute__((target("avx512f")))
+    void addAvx512(const std::int32_t* a, const std::int32_t* b, std::int32_t* out, std::size_t count)
+    {
+        std::size_t i{ 0 };
+        for (; i + 16 <= count; i += 16)
+        {
+            __m512i x{ _mm512_loadu_si512(a + i) };
+            __m512i y{ _mm512_loadu_si512(b + i) };
+            _mm512_storeu_si512(out + i, _mm512_add_epi32(x, y));
+        }
+
+        // The last 0-15 elements are handled with a lane mask instead of a scalar loop.
+        if (i < count)
+        {
+            __mmask16 tail{ static_cast<__mmask16>((1u << (count - i)) - 1) };
+            __m512i x{ _mm512_maskz_loadu_epi32(tail, a + i) };
+            __m512i y{ _mm512_maskz_loadu_epi32(tail, b + i) };
+            _mm512_mask_storeu_epi32(out + i, tail, _mm512_add_epi32(x, y));
+        }
+    }
+#endif
+
+    AddImplementation selectAddImplementation()
+    {
+#ifdef ADD_HAS_X86_KERNELS
+        __builtin_cpu_init();
+
+        if (__builtin_cpu_supports("avx512f"))
+            return { addAvx512, "avx512" };
+        if (__builtin_cpu_supports("avx2"))
+            return { addAvx2, "avx2" };
+        if (__builtin_cpu_supports("sse4.2"))
+            return { addSse42, "sse4.2" };
+#endif
+        return { addScalar, "scalar" };
+    }
+
+    const AddImplementation& addImplementation()
+    {
+        static const AddImplementation implementation{ selectAddImplementation() };
+        return implementation;
+    }
+}
+
+void add(const std::int32_t* a, const std::int32_t* b, std::int32_t* out, std::size_t count)
+{
+    addImplementation().function(a, b, out, count);
+}
+
+const char* addImplementationName()
+{
+    return addImplementation().name;
+}
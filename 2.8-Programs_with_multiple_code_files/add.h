@@ -0,0 +1,23 @@
+#ifndef ADD_H
+#define ADD_H
+
+#include <cstddef>
+#include <cstdint>
+
+class BigInteger;
+
+int add(int x, int y);
+
+// For numbers of any size (see bigInteger.h): never overflows.
+BigInteger add(const BigInteger& x, const BigInteger& y);
+
+// Adds two int32 columns element by element: out[i] = a[i] + b[i] for i in [0, count).
+// Overflow wraps around (two's complement) the same way in every implementation.
+// out may be the same array as a or b, but must not partially overlap them.
+// The fastest implementation this CPU supports (scalar, SSE4.2, AVX2 or AVX-512) is picked once, on the first call.
+void add(const std::int32_t* a, const std::int32_t* b, std::int32_t* out, std::size_t count);
+
+// Name of the implementation the array add() dispatches to ("scalar", "sse4.2", "avx2" or "avx512").
+const char* addImplementationName();
+
+#endif
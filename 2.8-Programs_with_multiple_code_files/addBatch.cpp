@@ -0,0 +1,98 @@
+#include "addBatch.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "add.h"
+#include "bigInteger.h"
+#include "inputReader.h"
+#include "outputWriter.h"
+
+namespace
+{
+    // Pairs are gathered into two columns of this many values, and each full block is summed with a single array add().
+    constexpr std::size_t pairsPerBlock{ 4096 };
+}
+
+bool runAddBatch(InputReader& in, OutputWriter& out)
+{
+    std::vector<std::int32_t> firsts(pairsPerBlock);
+    std::vector<std::int32_t> seconds(pairsPerBlock);
+    std::vector<std::int32_t> sums(pairsPerBlock);
+
+    long long pairs{ 0 };
+    bool halfPair{ false };
+    bool moreInput{ true };
+
+    while (moreInput)
+    {
+        std::size_t count{ 0 };
+
+        while (count < pairsPerBlock)
+        {
+            if (!(in >> firsts[count]))
+            {
+                moreInput = false;
+                break;
+            }
+
+            if (!(in >> seconds[count]))
+            {
+                halfPair = true;
+                moreInput = false;
+                break;
+            }
+
+            ++count;
+        }
+
+        add(firsts.data(), seconds.data(), sums.data(), count);
+        for (std::size_t i{ 0 }; i < count; ++i)
+            out << sums[i] << '\n';
+
+        pairs += static_cast<long long>(count);
+    }
+
+    out.flush();
+
+    // The loop always ends on a failed extraction. That is only a clean finish if it failed because the input ran out between two pairs.
+    if (halfPair || !in.eof())
+    {
+        std::cerr << "Batch stopped after " << pairs << " pairs: expected two integers per pair.\n";
+        return false;
+    }
+
+    return true;
+}
+
+bool runBigAddBatch(InputReader& in, OutputWriter& out)
+{
+    BigInteger first{};
+    BigInteger second{};
+    long long pairs{ 0 };
+    bool halfPair{ false };
+
+    while (in >> first)
+    {
+        if (!(in >> second))
+        {
+            halfPair = true;
+            break;
+        }
+
+        out << add(first, second) << '\n';
+        ++pairs;
+    }
+
+    out.flush();
+
+    if (halfPair || !in.eof())
+    {
+        std::cerr << "Batch stopped after " << pairs << " pairs: expected two integers per pair.\n";
+        return false;
+    }
+
+    return true;
+}
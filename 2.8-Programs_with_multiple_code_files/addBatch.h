@@ -0,0 +1,15 @@
+#ifndef ADD_BATCH_H
+#define ADD_BATCH_H
+
+#include "inputReader.h"
+#include "outputWriter.h"
+
+// Batch mode for the adder: reads whitespace-separated "a b" pairs from in until end of input and writes add(a, b) for each pair, one sum per line, to out.
+// No prompts are printed. out is flushed when done.
+// Returns false if the input contained something that is not an integer or ended in the middle of a pair.
+bool runAddBatch(InputReader& in, OutputWriter& out);
+
+// The same for integers of any size: pairs are read and summed as BigIntegers, so nothing is clamped or wraps around.
+bool runBigAddBatch(InputReader& in, OutputWriter& out);
+
+#endif
@@ -0,0 +1,727 @@
+// Micro-benchmarks for the building blocks in this folder, so that performance claims can be checked on the machine at hand.
+// Usage: benchmark.out [suite...]
+// Without arguments every suite runs. Each measurement is the best of several runs, reported in nanoseconds per element.
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "add.h"
+#include "bigInteger.h"
+#include "divider.h"
+#include "fixedWidthArithmetic.h"
+#include "inputReader.h"
+#include "limbArithmetic.h"
+#include "outputWriter.h"
+#include "scale.h"
+
+namespace
+{
+    constexpr int runsPerMeasurement{ 5 };
+
+    // Stops the optimizer from deleting work whose result is never looked at.
+    volatile std::uint64_t sink{};
+
+    template <typename Function>
+    double bestNanosecondsPerElement(std::size_t elements, Function function)
+    {
+        double best{ 0.0 };
+
+        for (int run{ 0 }; run < runsPerMeasurement; ++run)
+        {
+            auto start{ std::chrono::steady_clock::now() };
+            function();
+            std::chrono::duration<double, std::nano> elapsed{ std::chrono::steady_clock::now() - start };
+
+            double perElement{ elapsed.count() / static_cast<double>(elements) };
+            if (run == 0 || perElement < best)
+                best = perElement;
+        }
+
+        return best;
+    }
+
+    void report(const char* name, double nanoseconds, double baseline)
+    {
+        std::cout << "  " << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(9) << nanoseconds << " ns/elem" << std::setw(9) << std::setprecision(2) << nanoseconds / baseline << "x\n";
+    }
+
+    std::vector<std::int32_t> randomColumn(std::size_t size, std::uint32_t seed)
+    {
+        std::mt19937 random{ seed };
+        std::vector<std::int32_t> column(size);
+        for (auto& value : column)
+            value = static_cast<std::int32_t>(random());
+
+        return column;
+    }
+
+    // Raw scalar loop vs the dispatched array add().
+    void benchmarkAdd()
+    {
+        constexpr std::size_t size{ 1 << 22 };
+        std::vector<std::int32_t> a{ randomColumn(size, 1) };
+        std::vector<std::int32_t> b{ randomColumn(size, 2) };
+        std::vector<std::int32_t> out(size);
+
+        std::cout << "add (" << size << " int32 pairs, dispatching to " << addImplementationName() << ")\n";
+
+        double scalar{ bestNanosecondsPerElement(size, [&]
+        {
+            for (std::size_t i{ 0 }; i < size; ++i)
+                out[i] = add(a[i], b[i]);
+            sink = sink + static_cast<std::uint32_t>(out[size / 2]);
+        }) };
+        report("add(int, int) per pair", scalar, scalar);
+
+        double array{ bestNanosecondsPerElement(size, [&]
+        {
+            add(a.data(), b.data(), out.data(), size);
+            sink = sink + static_cast<std::uint32_t>(out[size / 2]);
+        }) };
+        report("add(a, b, out, count)", array, scalar);
+    }
+
+    // Every overflow policy against a plain "out[i] = a[i] + b[i]" loop on large arrays.
+    void benchmarkArithmetic()
+    {
+        constexpr std::size_t size{ 1 << 22 };
+        std::vector<std::int32_t> a{ randomColumn(size, 3) };
+        std::vector<std::int32_t> b{ randomColumn(size, 4) };
+        std::vector<std::int32_t> out(size);
+        std::vector<std::int64_t> wideOut(size);
+
+        // Keep the raw loop free of overflow: the operands are halved.
+        for (std::size_t i{ 0 }; i < size; ++i)
+        {
+            a[i] /= 2;
+            b[i] /= 2;
+        }
+
+        std::cout << "arithmetic policies (" << size << " int32 pairs)\n";
+
+        double raw{ bestNanosecondsPerElement(size, [&]
+        {
+            for (std::size_t i{ 0 }; i < size; ++i)
+                out[i] = a[i] + b[i];
+            sink = sink + static_cast<std::uint32_t>(out[size / 2]);
+        }) };
+        report("raw a + b", raw, raw);
+
+        auto measure{ [&](const char* name, auto function)
+        {
+            report(name, bestNanosecondsPerElement(size, function), raw);
+        } };
+
+        measure("add<Unchecked>", [&] { sink = sink + arithmetic::add<arithmetic::Unchecked>(a.data(), b.data(), out.data(), size); });
+        measure("add<Wrap>", [&] { sink = sink + arithmetic::add<arithmetic::Wrap>(a.data(), b.data(), out.data(), size); });
+        measure("add<Saturate>", [&] { sink = sink + arithmetic::add<arithmetic::Saturate>(a.data(), b.data(), out.data(), size); });
+        measure("add<Checked>", [&] { sink = sink + arithmetic::add<arithmetic::Checked>(a.data(), b.data(), out.data(), size); });
+        measure("add<Widen>", [&] { sink = sink + arithmetic::add<arithmetic::Widen>(a.data(), b.data(), wideOut.data(), size); });
+        measure("mul<Saturate>", [&] { sink = sink + arithmetic::mul<arithmetic::Saturate>(a.data(), b.data(), out.data(), size); });
+        measure("mul<Checked>", [&] { sink = sink + arithmetic::mul<arithmetic::Checked>(a.data(), b.data(), out.data(), size); });
+    }
+
+    // The old input path (operator>> on a stream) against InputReader, both reading the same file of integers from disk.
+    void benchmarkInput()
+    {
+        constexpr std::size_t count{ 1 << 22 };
+        const std::string path{ "benchmark_input.txt" };
+
+        {
+            std::vector<std::int32_t> values{ randomColumn(count, 5) };
+            std::ofstream file{ path };
+            for (std::size_t i{ 0 }; i < count; ++i)
+                file << values[i] << ((i % 2 == 0) ? ' ' : '\n');
+        }
+
+        std::cout << "input (" << count << " integers from a file)\n";
+
+        double stream{ bestNanosecondsPerElement(count, [&]
+        {
+            std::ifstream file{ path };
+            std::int32_t value{};
+            std::int64_t sum{ 0 };
+            while (file >> value)
+                sum += value;
+            sink = sink + static_cast<std::uint64_t>(sum);
+        }) };
+        report("std::ifstream >> int", stream, stream);
+
+        double reader{ bestNanosecondsPerElement(count, [&]
+        {
+            std::FILE* file{ std::fopen(path.c_str(), "rb") };
+            InputReader in{ fileno(file) };
+            std::int32_t value{};
+            std::int64_t sum{ 0 };
+            while (in >> value)
+                sum += value;
+            std::fclose(file);
+            sink = sink + static_cast<std::uint64_t>(sum);
+        }) };
+        report("InputReader >> int", reader, stream);
+
+        std::remove(path.c_str());
+    }
+
+    // "stream << value << '\n'" against OutputWriter, both writing the same integers to a file on disk.
+    void benchmarkOutput()
+    {
+        constexpr std::size_t count{ 1 << 22 };
+        const std::string path{ "benchmark_output.txt" };
+        std::vector<std::int32_t> values{ randomColumn(count, 6) };
+
+        std::cout << "output (" << count << " integers to a file)\n";
+
+        double stream{ bestNanosecondsPerElement(count, [&]
+        {
+            std::ofstream file{ path };
+            for (std::int32_t value : values)
+                file << value << '\n';
+        }) };
+        report("std::ofstream << int", stream, stream);
+
+        double writer{ bestNanosecondsPerElement(count, [&]
+        {
+            std::FILE* file{ std::fopen(path.c_str(), "wb") };
+            {
+                OutputWriter out{ fileno(file) };
+                for (std::int32_t value : values)
+                    out << value << '\n';
+            }
+            std::fclose(file);
+        }) };
+        report("OutputWriter << int", writer, stream);
+
+        std::remove(path.c_str());
+    }
+
+    // The same, for doubles: the stream with setprecision(17), which every double survives but with up to 17 digits even for 0.1,
+    // against OutputWriter's shortest digits. Half the values are measurements with a few decimals, half are random bit patterns.
+    void benchmarkFloats()
+    {
+        constexpr std::size_t count{ 1 << 21 };
+        const std::string path{ "benchmark_output.txt" };
+
+        std::mt19937_64 random{ 8 };
+        std::vector<double> values(count);
+        for (std::size_t i{ 0 }; i < count; ++i)
+        {
+            std::uint64_t bits{ random() };
+            std::memcpy(&values[i], &bits, sizeof(bits));
+            if (i % 2 == 0 || !std::isfinite(values[i]))
+                values[i] = static_cast<double>(bits % 1000000) / 100.0;
+        }
+
+        // Reads the text back and counts the values that did not come back exactly.
+        auto countChanged{ [&](std::string_view text)
+        {
+            std::size_t changed{ 0 };
+            const char* current{ text.data() };
+            for (double value : values)
+            {
+                double back{};
+                current = std::from_chars(current, text.data() + text.size(), back).ptr + 1;
+                changed += back != value;
+            }
+
+            return changed;
+        } };
+
+        std::ostringstream defaultText{};
+        std::ostringstream preciseText{};
+        preciseText << std::setprecision(17);
+        OutputWriter shortestText{};
+        for (double value : values)
+        {
+            defaultText << value << '\n';
+            preciseText << value << '\n';
+            shortestText << value << '\n';
+        }
+
+        std::cout << "floats (" << count << " doubles to a file; values changed by the round trip: " << countChanged(defaultText.str()) << " with the default 6 digits, "
+                  << countChanged(preciseText.str()) << " with 17, " << countChanged(shortestText.text()) << " shortest; "
+                  << preciseText.str().size() << " against " << shortestText.text().size() << " bytes)\n";
+
+        double stream{ bestNanosecondsPerElement(count, [&]
+        {
+            std::ofstream file{ path };
+            file << std::setprecision(17);
+            for (double value : values)
+                file << value << '\n';
+        }) };
+        report("std::ofstream << double (17)", stream, stream);
+
+        double writer{ bestNanosecondsPerElement(count, [&]
+        {
+            std::FILE* file{ std::fopen(path.c_str(), "wb") };
+            {
+                OutputWriter out{ fileno(file) };
+                for (double value : values)
+                    out << value << '\n';
+            }
+            std::fclose(file);
+        }) };
+        report("OutputWriter << double", writer, stream);
+
+        for (FloatFormat format : { FloatFormat::fixed, FloatFormat::scientific })
+        {
+            double formatted{ bestNanosecondsPerElement(count, [&]
+            {
+                std::FILE* file{ std::fopen(path.c_str(), "wb") };
+                {
+                    OutputWriter out{ fileno(file) };
+                    for (double value : values)
+                        out.writeFloatingPoint(value, format) << '\n';
+                }
+                std::fclose(file);
+            }) };
+            report(format == FloatFormat::fixed ? "OutputWriter, fixed" : "OutputWriter, scientific", formatted, stream);
+        }
+
+        std::remove(path.c_str());
+    }
+
+    // Reading numbers back from a CSV file: std::strtod and std::from_chars against parseFloatingPoint.
+    void benchmarkParse()
+    {
+        constexpr std::size_t rows{ 1 << 18 };
+        constexpr std::size_t columns{ 4 };
+
+        // Columns like those of real data: prices with two decimals, measurements with a few more, numbers in scientific notation,
+        // and doubles written with all the digits they need (mostly 16 or 17), which no fast path takes.
+        std::mt19937_64 random{ 9 };
+        OutputWriter csv{};
+        for (std::size_t row{ 0 }; row < rows; ++row)
+        {
+            std::uint64_t bits{ random() };
+            double full{};
+            std::memcpy(&full, &bits, sizeof(bits));
+            if (!std::isfinite(full))
+                full = 0.5;
+
+            csv << static_cast<double>(random() % 100000) / 100.0 << ',';
+            csv << static_cast<double>(static_cast<std::int64_t>(random() % 2000000) - 1000000) / 10000.0 << ',';
+            csv.writeFloatingPoint(static_cast<double>(random() % 1000) * 1e-9, FloatFormat::scientific) << ',';
+            csv << (row % 4 == 0 ? full : static_cast<double>(random() % 1000)) << '\n';
+        }
+
+        const std::string_view text{ csv.text() };
+        const char* const first{ text.data() };
+        const char* const last{ first + text.size() };
+        const std::size_t count{ rows * columns };
+        std::vector<double> values{};
+        values.reserve(count);
+
+        std::cout << "parse (" << count << " numbers, " << text.size() << " bytes of comma separated text)\n";
+
+        auto reportParse{ [&](const char* name, double nanoseconds, double baseline)
+        {
+            std::cout << "  " << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(3)
+                      << std::setw(9) << nanoseconds << " ns/elem" << std::setw(9) << std::setprecision(2) << nanoseconds / baseline << "x"
+                      << std::setw(9) << std::setprecision(0) << static_cast<double>(text.size()) * 1000.0 / (nanoseconds * static_cast<double>(count)) << " MB/s\n";
+        } };
+
+        // The text is not null-terminated, but every number ends at a comma or a newline before the end, which is all strtod needs.
+        double strtod{ bestNanosecondsPerElement(count, [&]
+        {
+            values.clear();
+            const char* current{ first };
+            while (current != last)
+            {
+                char* end{};
+                values.push_back(std::strtod(current, &end));
+                current = end + 1;
+            }
+            sink = sink + values.size();
+        }) };
+        reportParse("std::strtod", strtod, strtod);
+
+        double fromChars{ bestNanosecondsPerElement(count, [&]
+        {
+            values.clear();
+            const char* current{ first };
+            while (current != last)
+            {
+                double value{};
+                current = std::from_chars(current, last, value).ptr + 1;
+                values.push_back(value);
+            }
+            sink = sink + values.size();
+        }) };
+        reportParse("std::from_chars", fromChars, strtod);
+
+        double single{ bestNanosecondsPerElement(count, [&]
+        {
+            values.clear();
+            const char* current{ first };
+            while (current != last)
+            {
+                double value{};
+                current = parseFloatingPoint(current, last, value).ptr + 1;
+                values.push_back(value);
+            }
+            sink = sink + values.size();
+        }) };
+        reportParse("parseFloatingPoint", single, strtod);
+    }
+
+    std::string randomDigits(std::size_t count, std::uint32_t seed)
+    {
+        std::mt19937 random{ seed };
+        std::string digits(count, '0');
+        for (char& digit : digits)
+            digit = static_cast<char>('0' + random() % 10);
+
+        digits[0] = static_cast<char>('1' + random() % 9);
+        return digits;
+    }
+
+    // The schoolbook way: one decimal digit per char, added right to left.
+    std::string addDecimalDigits(const std::string& x, const std::string& y)
+    {
+        const std::string& longer{ x.size() >= y.size() ? x : y };
+        const std::string& shorter{ x.size() >= y.size() ? y : x };
+
+        std::string sum(longer.size() + 1, '0');
+        int carry{ 0 };
+        for (std::size_t i{ 0 }; i < longer.size(); ++i)
+        {
+            int digit{ longer[longer.size() - 1 - i] - '0' + carry };
+            if (i < shorter.size())
+                digit += shorter[shorter.size() - 1 - i] - '0';
+
+            carry = digit >= 10;
+            sum[sum.size() - 1 - i] = static_cast<char>('0' + digit - 10 * carry);
+        }
+
+        sum[0] = static_cast<char>('0' + carry);
+        return carry ? sum : sum.substr(1);
+    }
+
+    // Adding two million-digit numbers: one decimal digit at a time against 64-bit limbs with add-with-carry.
+    void benchmarkBigInteger()
+    {
+        constexpr std::size_t digits{ 1000000 };
+        std::string xText{ randomDigits(digits, 7) };
+        std::string yText{ randomDigits(digits, 8) };
+
+        BigInteger x{};
+        BigInteger y{};
+        auto start{ std::chrono::steady_clock::now() };
+        parseBigInteger(xText, x);
+        parseBigInteger(yText, y);
+        std::chrono::duration<double, std::milli> parsing{ std::chrono::steady_clock::now() - start };
+
+        std::cout << "biginteger (two " << digits << "-digit numbers, " << x.limbs().size() << " limbs each, " << bigIntegerImplementationName()
+                  << " carry loop; converting both from decimal took " << std::fixed << std::setprecision(0) << parsing.count() << " ms)\n";
+
+        double decimal{ bestNanosecondsPerElement(digits, [&]
+        {
+            std::string sum{ addDecimalDigits(xText, yText) };
+            sink = sink + static_cast<std::uint64_t>(sum.back());
+        }) };
+        report("decimal digit strings", decimal, decimal);
+
+        BigInteger sum{};
+        double limbs{ bestNanosecondsPerElement(digits, [&]
+        {
+            sum = x + y;
+            sink = sink + sum.limbs().back();
+        }) };
+        report("BigInteger x + y", limbs, decimal);
+
+        double inPlace{ bestNanosecondsPerElement(digits, [&]
+        {
+            sum += x;
+            sink = sink + sum.limbs().back();
+        }) };
+        report("BigInteger sum += x", inPlace, decimal);
+
+        double difference{ bestNanosecondsPerElement(digits, [&]
+        {
+            sum -= y;
+            sink = sink + sum.limbs().back();
+        }) };
+        report("BigInteger sum -= y", difference, decimal);
+
+        std::cout << "  one million-digit sum: " << std::setprecision(1) << decimal * digits / 1000.0 << " us as digits, "
+                  << limbs * digits / 1000.0 << " us as limbs (" << inPlace * digits / 1000.0 << " us in place)\n";
+    }
+
+    BigInteger randomBigInteger(std::size_t limbCount, std::uint32_t seed)
+    {
+        std::mt19937_64 random{ seed };
+        std::vector<BigInteger::Limb> limbs(limbCount);
+        for (BigInteger::Limb& limb : limbs)
+            limb = random();
+
+        limbs.back() |= 1; // Exactly limbCount limbs.
+        return BigInteger::fromLimbs(std::move(limbs));
+    }
+
+    // Products of two numbers of the same size, from a few limbs to 100000 digits, against schoolbook multiplication.
+    void benchmarkMultiply()
+    {
+        std::cout << "multiply (n x n limbs; Karatsuba from " << limbs::karatsubaThreshold << " limbs, Toom-3 from " << limbs::toom3Threshold << ")\n";
+
+        for (std::size_t limbCount : { std::size_t{ 8 }, std::size_t{ 24 }, std::size_t{ 64 }, std::size_t{ 160 }, std::size_t{ 512 }, std::size_t{ 1600 }, std::size_t{ 5200 } })
+        {
+            BigInteger x{ randomBigInteger(limbCount, 9) };
+            BigInteger y{ randomBigInteger(limbCount, 10) };
+            std::size_t repetitions{ std::max<std::size_t>(1, (1u << 22) / (limbCount * limbCount)) };
+            std::vector<BigInteger::Limb> product(2 * limbCount);
+
+            double schoolbook{ bestNanosecondsPerElement(repetitions, [&]
+            {
+                for (std::size_t i{ 0 }; i < repetitions; ++i)
+                    limbs::multiplySchoolbook(x.limbs().data(), limbCount, y.limbs().data(), limbCount, product.data());
+                sink = sink + product.back();
+            }) };
+
+            double dispatched{ bestNanosecondsPerElement(repetitions, [&]
+            {
+                for (std::size_t i{ 0 }; i < repetitions; ++i)
+                {
+                    BigInteger result{ x * y };
+                    sink = sink + result.limbs().back();
+                }
+            }) };
+
+            std::string name{ std::to_string(limbCount) + " limbs (~" + std::to_string(limbCount * 64 * 30103 / 100000) + " digits)" };
+            std::cout << "  " << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(1)
+                      << "schoolbook " << std::setw(10) << schoolbook / 1000.0 << " us, x * y " << std::setw(10) << dispatched / 1000.0 << " us"
+                      << std::setw(9) << std::setprecision(2) << dispatched / schoolbook << "x\n";
+        }
+
+        BigInteger number{ randomBigInteger(52000, 11) };
+        double doubling{ bestNanosecondsPerElement(1, [&]
+        {
+            number *= 2;
+            number *= 3;
+            sink = sink + number.limbs().back();
+        }) };
+        std::cout << "  a million-digit number times 2 and then 3, in place: " << std::setprecision(1) << doubling / 1000.0 << " us\n";
+    }
+
+    // Decimal text to BigInteger and back, from a thousand to a million digits. The powers of ten that the conversions split at are
+    // made on first use; the biginteger suite's first conversion (when it runs) includes that, the best of several runs here does not.
+    void benchmarkDecimal()
+    {
+        std::cout << "decimal (parse, toString, and OutputWriter << into memory; milliseconds per number)\n";
+
+        for (std::size_t digits : { std::size_t{ 1000 }, std::size_t{ 10000 }, std::size_t{ 100000 }, std::size_t{ 1000000 } })
+        {
+            std::string text{ randomDigits(digits, 12) };
+            BigInteger value{};
+
+            auto start{ std::chrono::steady_clock::now() };
+            parseBigInteger(text, value);
+            bool roundTrip{ value.toString() == text };
+            std::chrono::duration<double, std::milli> first{ std::chrono::steady_clock::now() - start };
+
+            double parsing{ bestNanosecondsPerElement(1, [&]
+            {
+                parseBigInteger(text, value);
+                sink = sink + value.limbs().back();
+            }) };
+
+            double printing{ bestNanosecondsPerElement(1, [&]
+            {
+                std::string printed{ value.toString() };
+                sink = sink + static_cast<std::uint64_t>(printed.back());
+            }) };
+
+            OutputWriter writer{};
+            double writing{ bestNanosecondsPerElement(1, [&]
+            {
+                writer.clear();
+                writer << value;
+                sink = sink + static_cast<std::uint64_t>(writer.text().back());
+            }) };
+
+            std::string name{ std::to_string(digits) + " digits" };
+            std::cout << "  " << std::left << std::setw(16) << name << std::right << std::fixed << std::setprecision(3)
+                      << "parse " << std::setw(9) << parsing / 1e6 << ", toString " << std::setw(9) << printing / 1e6
+                      << ", writer " << std::setw(9) << writing / 1e6 << "; first round trip " << std::setw(9) << first.count()
+                      << (roundTrip ? "" : " (MISMATCH)") << '\n';
+        }
+    }
+
+    // The multiply loop against the kernels for constant factors, on a column that stays in the L1 cache and on one that does not fit any cache.
+    void benchmarkScale()
+    {
+        std::cout << "scale (int32 column times a factor given at run time: multiply loop vs the factor's own kernel)\n";
+
+        for (std::size_t size : { std::size_t{ 4096 }, std::size_t{ 1 } << 22 })
+        {
+            std::vector<std::int32_t> in{ randomColumn(size, 5) };
+            std::vector<std::int32_t> out(size);
+            std::size_t repetitions{ (std::size_t{ 1 } << 24) / size };
+
+            for (std::int32_t factor : { 2, 3, 10, 16 })
+            {
+                double generic{ bestNanosecondsPerElement(size * repetitions, [&]
+                {
+                    for (std::size_t i{ 0 }; i < repetitions; ++i)
+                        arithmetic::scaleGeneric(in.data(), out.data(), size, factor);
+                    sink = sink + static_cast<std::uint32_t>(out[size / 2]);
+                }) };
+
+                double specialized{ bestNanosecondsPerElement(size * repetitions, [&]
+                {
+                    for (std::size_t i{ 0 }; i < repetitions; ++i)
+                        arithmetic::scale(in.data(), out.data(), size, factor);
+                    sink = sink + static_cast<std::uint32_t>(out[size / 2]);
+                }) };
+
+                std::string name{ std::to_string(size) + " ints, x " + std::to_string(factor) };
+                std::cout << "  " << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(3)
+                          << "multiply " << std::setw(7) << generic << " ns/elem, kernel " << std::setw(7) << specialized << " ns/elem"
+                          << std::setw(9) << std::setprecision(2) << specialized / generic << "x\n";
+            }
+        }
+    }
+
+    // The division instruction against a divider, for each kind of divisor the magic numbers treat differently.
+    // The column stays in the L1 cache, so that the loop and not the memory sets the pace.
+    void benchmarkDivide()
+    {
+        constexpr std::size_t size{ 4096 };
+        constexpr std::size_t repetitions{ (std::size_t{ 1 } << 24) / size };
+        std::vector<std::int32_t> in{ randomColumn(size, 6) };
+        std::vector<std::uint32_t> unsignedIn(in.begin(), in.end());
+        std::vector<std::int32_t> out(size);
+        std::vector<std::uint32_t> unsignedOut(size);
+
+        std::cout << "divide (" << size << " int32 / uint32 by a divisor given at run time: / and % vs a divider)\n";
+
+        auto compare{ [&](const std::string& name, auto plainLoop, auto dividerLoop)
+        {
+            double plain{ bestNanosecondsPerElement(size * repetitions, [&]
+            {
+                for (std::size_t i{ 0 }; i < repetitions; ++i)
+                    plainLoop();
+                sink = sink + static_cast<std::uint32_t>(out[size / 2]) + unsignedOut[size / 2];
+            }) };
+
+            double divider{ bestNanosecondsPerElement(size * repetitions, [&]
+            {
+                for (std::size_t i{ 0 }; i < repetitions; ++i)
+                    dividerLoop();
+                sink = sink + static_cast<std::uint32_t>(out[size / 2]) + unsignedOut[size / 2];
+            }) };
+
+            std::cout << "  " << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(3)
+                      << "plain " << std::setw(7) << plain << " ns/elem, divider " << std::setw(7) << divider << " ns/elem"
+                      << std::setw(9) << std::setprecision(2) << divider / plain << "x\n";
+        } };
+
+        // The plain loops read the divisor from a volatile on every pass, so that the compiler can neither see the number
+        // (as if it had been read from the input) nor skip the passes after the first, which would all give the same result.
+        for (std::int32_t d : { 7, 10, 16, 1000, -3 })
+        {
+            volatile std::int32_t divisor{ d };
+            arithmetic::SignedDivider signedDivider{ d };
+
+            compare("int32 / " + std::to_string(d), [&]
+            {
+                std::int32_t runTimeDivisor{ divisor };
+                for (std::size_t i{ 0 }; i < size; ++i)
+                    out[i] = in[i] / runTimeDivisor;
+            }, [&]
+            {
+                arithmetic::divide(in.data(), out.data(), size, signedDivider);
+            });
+
+            compare("int32 % " + std::to_string(d), [&]
+            {
+                std::int32_t runTimeDivisor{ divisor };
+                for (std::size_t i{ 0 }; i < size; ++i)
+                    out[i] = in[i] % runTimeDivisor;
+            }, [&]
+            {
+                arithmetic::remainder(in.data(), out.data(), size, signedDivider);
+            });
+
+            if (d < 0)
+                continue;
+
+            std::uint32_t u{ static_cast<std::uint32_t>(d) };
+            arithmetic::UnsignedDivider unsignedDivider{ u };
+
+            compare("uint32 / " + std::to_string(u), [&]
+            {
+                std::uint32_t runTimeDivisor{ static_cast<std::uint32_t>(divisor) };
+                for (std::size_t i{ 0 }; i < size; ++i)
+                    unsignedOut[i] = unsignedIn[i] / runTimeDivisor;
+            }, [&]
+            {
+                arithmetic::divide(unsignedIn.data(), unsignedOut.data(), size, unsignedDivider);
+            });
+
+            compare("uint32 % " + std::to_string(u), [&]
+            {
+                std::uint32_t runTimeDivisor{ static_cast<std::uint32_t>(divisor) };
+                for (std::size_t i{ 0 }; i < size; ++i)
+                    unsignedOut[i] = unsignedIn[i] % runTimeDivisor;
+            }, [&]
+            {
+                arithmetic::remainder(unsignedIn.data(), unsignedOut.data(), size, unsignedDivider);
+            });
+        }
+    }
+
+    struct Suite
+    {
+        const char* name;
+        void (*run)();
+    };
+
+    constexpr Suite suites[]{
+        { "add", benchmarkAdd },
+        { "arithmetic", benchmarkArithmetic },
+        { "biginteger", benchmarkBigInteger },
+        { "decimal", benchmarkDecimal },
+        { "divide", benchmarkDivide },
+        { "floats", benchmarkFloats },
+        { "input", benchmarkInput },
+        { "multiply", benchmarkMultiply },
+        { "output", benchmarkOutput },
+        { "parse", benchmarkParse },
+        { "scale", benchmarkScale },
+    };
+}
+
+int main(int argc, char* argv[])
+{
+    for (const Suite& suite : suites)
+    {
+        bool selected{ argc == 1 };
+        for (int i{ 1 }; i < argc; ++i)
+        {
+            if (std::strcmp(argv[i], suite.name) == 0)
+                selected = true;
+        }
+
+        if (selected)
+            suite.run();
+    }
+
+    return 0;
+}
@@ -0,0 +1,670 @@
+#include "bigInteger.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "inputReader.h"
+#include "limbArithmetic.h"
+#include "outputWriter.h"
+
+namespace
+{
+    using limbs::Limb;
+    static_assert(std::is_same_v<Limb, BigInteger::Limb>);
+
+    int compareMagnitudes(const std::vector<Limb>& x, const std::vector<Limb>& y)
+    {
+        if (x.size() != y.size())
+            return x.size() < y.size() ? -1 : 1;
+
+        return limbs::compare(x.data(), y.data(), x.size());
+    }
+
+    // value = value * factor + addend.
+    void multiplyAdd(std::vector<Limb>& value, Limb factor, Limb addend)
+    {
+        value.push_back(limbs::multiplyByLimb(value.data(), value.size(), factor, value.data()));
+        limbs::addInto(value.data(), value.size(), &addend, 1);
+
+        if (value.back() == 0)
+            value.pop_back();
+    }
+
+    // Divides value by divisor (below 2^32) in place and returns the remainder. Each limb is divided as two 32-bit halves,
+    // so that every step is a 64-bit by 32-bit division that the hardware does directly.
+    std::uint32_t divideSmall(std::vector<Limb>& value, std::uint32_t divisor)
+    {
+        Limb remainder{ 0 };
+        for (std::size_t i{ value.size() }; i-- > 0;)
+        {
+            Limb high{ (remainder << 32) | (value[i] >> 32) };
+            Limb highQuotient{ high / divisor };
+            remainder = high % divisor;
+
+            Limb low{ (remainder << 32) | (value[i] & 0xFFFFFFFF) };
+            Limb lowQuotient{ low / divisor };
+            remainder = low % divisor;
+
+            value[i] = (highQuotient << 32) | lowQuotient;
+        }
+
+        while (!value.empty() && value.back() == 0)
+            value.pop_back();
+
+        return static_cast<std::uint32_t>(remainder);
+    }
+
+    BigInteger fromRange(const Limb* first, std::size_t count)
+    {
+        return BigInteger::fromLimbs(std::vector<Limb>(first, first + count));
+    }
+
+    BigInteger divideExactly(const BigInteger& x, Limb oddDivisor)
+    {
+        std::vector<Limb> quotient(x.limbs().size());
+        limbs::divideExact(x.limbs().data(), quotient.size(), oddDivisor, quotient.data());
+        return BigInteger::fromLimbs(std::move(quotient), x.isNegative());
+    }
+
+    BigInteger halve(const BigInteger& x)
+    {
+        std::vector<Limb> half(x.limbs().size());
+        limbs::shiftRight(x.limbs().data(), half.size(), 1, half.data());
+        return BigInteger::fromLimbs(std::move(half), x.isNegative());
+    }
+
+    // Toom-3 for two numbers of count limbs: split each into three parts of k limbs, x = x2 * B^2 + x1 * B + x0 (B = 2^(64 * k)),
+    // and the product is a polynomial of degree 4 in B. Five values of it, at 0, 1, -1, -2 and infinity, pin down its coefficients,
+    // and each value is one product of third-size numbers: five multiplications where schoolbook would take nine.
+    // The evaluation and interpolation steps are Bodrato's; some values along the way are negative, which BigInteger takes care of.
+    std::vector<Limb> multiplyToom3(const Limb* x, const Limb* y, std::size_t count)
+    {
+        std::size_t k{ (count + 2) / 3 };
+
+        BigInteger x0{ fromRange(x, k) };
+        BigInteger x1{ fromRange(x + k, k) };
+        BigInteger x2{ fromRange(x + 2 * k, count - 2 * k) };
+        BigInteger y0{ fromRange(y, k) };
+        BigInteger y1{ fromRange(y + k, k) };
+        BigInteger y2{ fromRange(y + 2 * k, count - 2 * k) };
+
+        auto evaluate{ [](const BigInteger& part0, const BigInteger& part1, const BigInteger& part2, BigInteger& atOne, BigInteger& atMinusOne, BigInteger& atMinusTwo)
+        {
+            BigInteger outer{ part0 + part2 };
+            atOne = outer + part1;
+            atMinusOne = outer - part1;
+            atMinusTwo = atMinusOne + part2;
+            atMinusTwo += atMinusTwo;
+            atMinusTwo -= part0;
+        } };
+
+        BigInteger xOne{};
+        BigInteger xMinusOne{};
+        BigInteger xMinusTwo{};
+        BigInteger yOne{};
+        BigInteger yMinusOne{};
+        BigInteger yMinusTwo{};
+        evaluate(x0, x1, x2, xOne, xMinusOne, xMinusTwo);
+        evaluate(y0, y1, y2, yOne, yMinusOne, yMinusTwo);
+
+        BigInteger r0{ x0 * y0 };
+        BigInteger rOne{ xOne * yOne };
+        BigInteger rMinusOne{ xMinusOne * yMinusOne };
+        BigInteger rMinusTwo{ xMinusTwo * yMinusTwo };
+        BigInteger r4{ x2 * y2 };
+
+        BigInteger r3{ divideExactly(rMinusTwo - rOne, 3) };
+        BigInteger r1{ halve(rOne - rMinusOne) };
+        BigInteger r2{ rMinusOne - r0 };
+        r3 = halve(r2 - r3) + r4 + r4;
+        r2 += r1;
+        r2 -= r4;
+        r1 -= r3;
+
+        // The coefficients are sums of products of the parts, so none of them is negative, and each fits where it goes.
+        std::vector<Limb> product(2 * count);
+        const BigInteger* coefficients[]{ &r0, &r1, &r2, &r3, &r4 };
+        for (std::size_t i{ 0 }; i < 5; ++i)
+        {
+            const std::vector<Limb>& coefficient{ coefficients[i]->limbs() };
+            limbs::addInto(product.data() + i * k, product.size() - i * k, coefficient.data(), coefficient.size());
+        }
+
+        return product;
+    }
+
+    // The magnitude of x * y, by the method that suits the sizes.
+    std::vector<Limb> multiplyMagnitudes(const Limb* x, std::size_t xCount, const Limb* y, std::size_t yCount)
+    {
+        if (xCount < yCount)
+        {
+            std::swap(x, y);
+            std::swap(xCount, yCount);
+        }
+
+        if (yCount == 0)
+            return {};
+
+        std::vector<Limb> product(xCount + yCount);
+
+        if (yCount == 1)
+        {
+            product[xCount] = limbs::multiplyByLimb(x, xCount, y[0], product.data());
+            return product;
+        }
+
+        if (yCount < limbs::karatsubaThreshold)
+        {
+            limbs::multiplySchoolbook(x, xCount, y, yCount, product.data());
+            return product;
+        }
+
+        if (xCount == yCount)
+        {
+            if (yCount >= limbs::toom3Threshold)
+                return multiplyToom3(x, y, yCount);
+
+            std::vector<Limb> scratch(limbs::karatsubaScratchSize(yCount));
+            limbs::multiplyKaratsuba(x, y, yCount, product.data(), scratch.data());
+            return product;
+        }
+
+        // A long number times a shorter one: the long one in pieces as long as the short one, each multiplied by it and added in at its place.
+        for (std::size_t offset{ 0 }; offset < xCount; offset += yCount)
+        {
+            std::size_t pieceCount{ std::min(yCount, xCount - offset) };
+            std::vector<Limb> piece{ multiplyMagnitudes(x + offset, pieceCount, y, yCount) };
+            limbs::addInto(product.data() + offset, product.size() - offset, piece.data(), piece.size());
+        }
+
+        return product;
+    }
+
+    // 19 decimal digits are the most that always fit in a limb.
+    constexpr int digitsPerLimb{ 19 };
+    constexpr Limb limbPowersOfTen[]{
+        1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull, 1000000000ull,
+        10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull, 100000000000000ull, 1000000000000000ull,
+        10000000000000000ull, 100000000000000000ull, 1000000000000000000ull, 10000000000000000000ull,
+    };
+
+    // Decimal conversion splits numbers in halves at the powers 10^(19 * 2^level), down to this level (608 digits, 32 limbs),
+    // below which the quadratic conversions a limb at a time are faster.
+    constexpr std::size_t conversionBaseLevel{ 5 };
+
+    std::size_t digitsAtLevel(std::size_t level)
+    {
+        return std::size_t{ digitsPerLimb } << level;
+    }
+
+    // floor(2^(2 * bits) / d) for a d of exactly bits bits, from an estimate base * 2^shift with about half of its bits right:
+    // one step of Newton's iteration doubles that, and the last few units are then counted out exactly.
+    // The estimate's low bits are all zero, so the products take base alone, which is half as long.
+    BigInteger refineReciprocal(const BigInteger& d, std::size_t bits, const BigInteger& base, std::size_t shift)
+    {
+        BigInteger error{ (BigInteger{ 1 } << (2 * bits)) - ((d * base) << shift) };
+        BigInteger correction{ (base * error) >> (2 * bits - shift) };
+        BigInteger estimate{ (base << shift) + correction };
+        error -= d * correction;
+
+        while (error.isNegative())
+        {
+            estimate -= 1;
+            error += d;
+        }
+
+        while (error >= d)
+        {
+            estimate += 1;
+            error -= d;
+        }
+
+        return estimate;
+    }
+
+    // The same from nothing: the estimate is the reciprocal of d's top half, scaled up.
+    BigInteger reciprocal(const BigInteger& d, std::size_t bits)
+    {
+        if (bits <= 31)
+            return BigInteger{ static_cast<long long>((Limb{ 1 } << (2 * bits)) / d.limbs()[0]) };
+
+        std::size_t highBits{ bits / 2 + 2 };
+        std::size_t dropped{ bits - highBits };
+        return refineReciprocal(d, bits, reciprocal(d >> dropped, highBits), dropped);
+    }
+
+    struct PowerOfTen
+    {
+        BigInteger value{}; // 10^(19 * 2^level)
+        std::size_t bits{ 0 }; // value.bitLength()
+        BigInteger reciprocal{}; // floor(2^(2 * bits) / value), once a division has needed it
+    };
+
+    // The powers are made by squaring, once per program, as conversions first need them. They are shared between threads, so they are
+    // guarded, and kept in a deque, where adding a level does not move the ones handed out before.
+    const PowerOfTen& powerOfTen(std::size_t level, bool withReciprocal)
+    {
+        static std::mutex mutex{};
+        static std::deque<PowerOfTen> powers{};
+        std::lock_guard<std::mutex> lock{ mutex };
+
+        if (powers.empty())
+        {
+            BigInteger first{ BigInteger::fromLimbs({ limbPowersOfTen[digitsPerLimb] }) };
+            std::size_t bits{ first.bitLength() };
+            powers.push_back({ std::move(first), bits, {} });
+        }
+
+        while (powers.size() <= level)
+        {
+            BigInteger square{ powers.back().value * powers.back().value };
+            std::size_t bits{ square.bitLength() };
+            powers.push_back({ std::move(square), bits, {} });
+        }
+
+        if (withReciprocal && powers[level].reciprocal.isZero())
+        {
+            // Each level's reciprocal is the square of the one below (as 10^(2m) is the square of 10^m), good to about half its bits.
+            std::size_t first{ level };
+            while (first > 0 && powers[first - 1].reciprocal.isZero())
+                --first;
+
+            for (std::size_t i{ first }; i <= level; ++i)
+            {
+                PowerOfTen& power{ powers[i] };
+                if (i == 0)
+                {
+                    power.reciprocal = reciprocal(power.value, power.bits);
+                    continue;
+                }
+
+                // below.reciprocal^2 is about 2^squareScale / power.value, and squareScale is at least 2 * power.bits (as power.value < 2^(2 * below.bits)).
+                const PowerOfTen& below{ powers[i - 1] };
+                BigInteger square{ below.reciprocal * below.reciprocal };
+                std::size_t squareScale{ 4 * below.bits };
+                std::size_t dropped{ std::max(square.bitLength() - (power.bits / 2 + 4), squareScale - 2 * power.bits) };
+                power.reciprocal = refineReciprocal(power.value, power.bits, square >> dropped, dropped - (squareScale - 2 * power.bits));
+            }
+        }
+
+        return powers[level];
+    }
+
+    // quotient = x / power and remainder = x % power, for 0 <= x < power^2: two multiplications instead of a long division.
+    // Only the top bits of x and of the reciprocal matter for the quotient, as many as it has. The estimate from them is never too big
+    // and at most a few too small.
+    void divideByPower(const BigInteger& x, const PowerOfTen& power, BigInteger& quotient, BigInteger& remainder)
+    {
+        std::size_t bits{ x.bitLength() };
+        if (bits < power.bits)
+        {
+            quotient = BigInteger{};
+            remainder = x;
+        }
+        else
+        {
+            std::size_t xDropped{ power.bits - 1 };
+            std::size_t reciprocalDropped{ 2 * power.bits - bits };
+            quotient = ((x >> xDropped) * (power.reciprocal >> reciprocalDropped)) >> (2 * power.bits - xDropped - reciprocalDropped);
+            remainder = x - quotient * power.value;
+        }
+
+        while (remainder >= power.value)
+        {
+            remainder -= power.value;
+            quotient += 1;
+        }
+    }
+
+    // Writes the digits of x (not negative) at out and returns their end: exactly width digits if padded, otherwise without leading zeros.
+    // Nine digits at a time, least significant first, into a buffer that holds the width of the base level.
+    char* writeDigitsQuadratic(const BigInteger& x, std::size_t width, bool padded, char* out)
+    {
+        constexpr std::uint32_t billion{ 1000000000 };
+
+        char digits[(digitsPerLimb << conversionBaseLevel) + 9];
+        char* end{ digits + sizeof(digits) };
+        std::fill(digits, end, '0');
+
+        char* first{ end };
+        std::vector<Limb> rest{ x.limbs() };
+        while (!rest.empty())
+        {
+            std::uint32_t chunk{ divideSmall(rest, billion) };
+            for (int i{ 0 }; i < 9; ++i)
+            {
+                *--first = static_cast<char>('0' + chunk % 10);
+                chunk /= 10;
+            }
+        }
+
+        if (padded)
+            return std::copy(end - width, end, out);
+
+        // Zero is still "0".
+        first = std::min(first, end - 1);
+        while (*first == '0' && first + 1 < end)
+            ++first;
+
+        return std::copy(first, end, out);
+    }
+
+    // Writes x (0 <= x < 10^(19 * 2^level)) like writeDigitsQuadratic, with a width of 19 * 2^level digits if padded.
+    // Above the base level x is split at the square root of that bound, and both halves written the same way, so that the cost is
+    // a few multiplications of each size instead of one division by 10^9 per nine digits.
+    char* writeDigits(const BigInteger& x, std::size_t level, bool padded, char* out)
+    {
+        if (level <= conversionBaseLevel)
+            return writeDigitsQuadratic(x, digitsAtLevel(level), padded, out);
+
+        BigInteger high{};
+        BigInteger low{};
+        divideByPower(x, powerOfTen(level - 1, true), high, low);
+
+        if (!padded && high.isZero())
+            return writeDigits(low, level - 1, false, out);
+
+        out = writeDigits(high, level - 1, padded, out);
+        return writeDigits(low, level - 1, true, out);
+    }
+
+    // At least the number of characters that writeDecimal writes. log10(2) is just below 0.30103, and one more is for the sign.
+    std::size_t decimalLengthBound(const BigInteger& value)
+    {
+        return value.bitLength() * 30103 / 100000 + 2;
+    }
+
+    char* writeDecimal(const BigInteger& value, char* out)
+    {
+        std::size_t digitBound{ decimalLengthBound(value) - 1 };
+        std::size_t level{ conversionBaseLevel };
+        while (digitsAtLevel(level) < digitBound)
+            ++level;
+
+        if (!value.isNegative())
+            return writeDigits(value, level, false, out);
+
+        *out++ = '-';
+        return writeDigits(-value, level, false, out);
+    }
+
+    // The value of a run of digits (and nothing else), nineteen at a time. The first chunk takes what is left over, so that all the others are full.
+    BigInteger parseDigitsQuadratic(std::string_view digits)
+    {
+        std::vector<Limb> value{};
+        value.reserve(digits.size() / digitsPerLimb + 1);
+
+        std::size_t chunkLength{ digits.size() % digitsPerLimb == 0 ? digitsPerLimb : digits.size() % digitsPerLimb };
+        for (std::size_t position{ 0 }; position < digits.size(); position += chunkLength, chunkLength = digitsPerLimb)
+        {
+            Limb chunk{ 0 };
+            for (std::size_t i{ 0 }; i < chunkLength; ++i)
+                chunk = chunk * 10 + static_cast<Limb>(digits[position + i] - '0');
+
+            multiplyAdd(value, limbPowersOfTen[chunkLength], chunk);
+        }
+
+        return BigInteger::fromLimbs(std::move(value));
+    }
+
+    // The same, for any length: the last 19 * 2^level digits (the most that leave some in front) are parsed on their own,
+    // and the ones in front are multiplied by 10^(19 * 2^level).
+    BigInteger parseDigits(std::string_view digits)
+    {
+        if (digits.size() <= digitsAtLevel(conversionBaseLevel))
+            return parseDigitsQuadratic(digits);
+
+        std::size_t level{ conversionBaseLevel };
+        while (digitsAtLevel(level + 1) < digits.size())
+            ++level;
+
+        std::size_t highLength{ digits.size() - digitsAtLevel(level) };
+        BigInteger value{ parseDigits(digits.substr(0, highLength)) * powerOfTen(level, false).value };
+        value += parseDigits(digits.substr(highLength));
+        return value;
+    }
+}
+
+BigInteger::BigInteger(long long value)
+    : m_negative{ value < 0 }
+{
+    // Negating as unsigned also works for the smallest long long, which has no positive counterpart.
+    unsigned long long magnitude{ static_cast<unsigned long long>(value) };
+    if (m_negative)
+        magnitude = 0ull - magnitude;
+
+    if (magnitude != 0)
+        m_limbs.push_back(magnitude);
+}
+
+BigInteger BigInteger::fromLimbs(std::vector<Limb> limbs, bool negative)
+{
+    BigInteger result{};
+    result.m_limbs = std::move(limbs);
+    result.m_negative = negative;
+    result.normalize();
+    return result;
+}
+
+void BigInteger::normalize()
+{
+    while (!m_limbs.empty() && m_limbs.back() == 0)
+        m_limbs.pop_back();
+
+    if (m_limbs.empty())
+        m_negative = false;
+}
+
+void BigInteger::assignSum(const std::vector<Limb>& x, const std::vector<Limb>& y, bool negative)
+{
+    std::size_t xCount{ x.size() };
+    std::size_t yCount{ y.size() };
+
+    // Resizing first: x or y may be m_limbs itself, whose values stay where they are when it grows.
+    m_limbs.resize(xCount + 1);
+    Limb* out{ m_limbs.data() };
+
+    unsigned char carry{ limbs::add(x.data(), y.data(), out, yCount, 0) };
+    out[xCount] = limbs::propagateCarry(x.data() + yCount, out + yCount, xCount - yCount, carry);
+
+    m_negative = negative;
+    normalize();
+}
+
+void BigInteger::assignDifference(const std::vector<Limb>& x, const std::vector<Limb>& y, bool negative)
+{
+    std::size_t xCount{ x.size() };
+    std::size_t yCount{ y.size() };
+
+    m_limbs.resize(xCount);
+    Limb* out{ m_limbs.data() };
+
+    unsigned char borrow{ limbs::subtract(x.data(), y.data(), out, yCount, 0) };
+    limbs::propagateBorrow(x.data() + yCount, out + yCount, xCount - yCount, borrow);
+
+    m_negative = negative;
+    normalize();
+}
+
+void BigInteger::assignSignedSum(const BigInteger& x, const BigInteger& y, bool yNegative)
+{
+    if (x.m_negative == yNegative)
+    {
+        if (x.m_limbs.size() >= y.m_limbs.size())
+            assignSum(x.m_limbs, y.m_limbs, yNegative);
+        else
+            assignSum(y.m_limbs, x.m_limbs, yNegative);
+    }
+    else if (compareMagnitudes(x.m_limbs, y.m_limbs) >= 0)
+        assignDifference(x.m_limbs, y.m_limbs, x.m_negative);
+    else
+        assignDifference(y.m_limbs, x.m_limbs, yNegative);
+}
+
+BigInteger& BigInteger::operator+=(const BigInteger& other)
+{
+    assignSignedSum(*this, other, other.m_negative);
+    return *this;
+}
+
+BigInteger& BigInteger::operator-=(const BigInteger& other)
+{
+    assignSignedSum(*this, other, !other.m_negative);
+    return *this;
+}
+
+BigInteger operator+(const BigInteger& x, const BigInteger& y)
+{
+    BigInteger result{};
+    result.assignSignedSum(x, y, y.m_negative);
+    return result;
+}
+
+BigInteger operator-(const BigInteger& x, const BigInteger& y)
+{
+    BigInteger result{};
+    result.assignSignedSum(x, y, !y.m_negative);
+    return result;
+}
+
+BigInteger operator-(const BigInteger& x)
+{
+    BigInteger result{ x };
+    result.m_negative = !x.m_negative && !x.isZero();
+    return result;
+}
+
+BigInteger operator*(const BigInteger& x, const BigInteger& y)
+{
+    return BigInteger::fromLimbs(multiplyMagnitudes(x.m_limbs.data(), x.m_limbs.size(), y.m_limbs.data(), y.m_limbs.size()), x.m_negative != y.m_negative);
+}
+
+BigInteger& BigInteger::operator*=(const BigInteger& other)
+{
+    // By a single limb (doubling, tripling, ...): in place, without a new vector.
+    if (other.m_limbs.size() == 1)
+    {
+        Limb top{ limbs::multiplyByLimb(m_limbs.data(), m_limbs.size(), other.m_limbs[0], m_limbs.data()) };
+        if (top != 0)
+            m_limbs.push_back(top);
+
+        m_negative = m_negative != other.m_negative;
+        normalize();
+        return *this;
+    }
+
+    *this = *this * other;
+    return *this;
+}
+
+int compare(const BigInteger& x, const BigInteger& y)
+{
+    if (x.m_negative != y.m_negative)
+        return x.m_negative ? -1 : 1;
+
+    int magnitude{ compareMagnitudes(x.m_limbs, y.m_limbs) };
+    return x.m_negative ? -magnitude : magnitude;
+}
+
+std::size_t BigInteger::bitLength() const
+{
+    if (m_limbs.empty())
+        return 0;
+
+    std::size_t topBits{ 0 };
+    for (Limb top{ m_limbs.back() }; top != 0; top >>= 1)
+        ++topBits;
+
+    return (m_limbs.size() - 1) * 64 + topBits;
+}
+
+BigInteger operator<<(const BigInteger& x, std::size_t bits)
+{
+    if (x.isZero())
+        return x;
+
+    std::size_t limbShift{ bits / 64 };
+    std::size_t count{ x.m_limbs.size() };
+
+    std::vector<Limb> shifted(limbShift + count + 1);
+    shifted[limbShift + count] = limbs::shiftLeft(x.m_limbs.data(), count, static_cast<unsigned>(bits % 64), shifted.data() + limbShift);
+    return BigInteger::fromLimbs(std::move(shifted), x.m_negative);
+}
+
+BigInteger operator>>(const BigInteger& x, std::size_t bits)
+{
+    std::size_t limbShift{ bits / 64 };
+    if (limbShift >= x.m_limbs.size())
+        return BigInteger{};
+
+    std::vector<Limb> shifted(x.m_limbs.size() - limbShift);
+    limbs::shiftRight(x.m_limbs.data() + limbShift, shifted.size(), static_cast<unsigned>(bits % 64), shifted.data());
+    return BigInteger::fromLimbs(std::move(shifted), x.m_negative);
+}
+
+std::string BigInteger::toString() const
+{
+    std::string text(decimalLengthBound(*this), '\0');
+    char* end{ writeDecimal(*this, text.data()) };
+    text.resize(static_cast<std::size_t>(end - text.data()));
+    return text;
+}
+
+bool parseBigInteger(std::string_view text, BigInteger& value)
+{
+    bool negative{ false };
+    if (!text.empty() && (text.front() == '+' || text.front() == '-'))
+    {
+        negative = text.front() == '-';
+        text.remove_prefix(1);
+    }
+
+    if (text.empty())
+        return false;
+
+    for (char c : text)
+    {
+        if (c < '0' || c > '9')
+            return false;
+    }
+
+    BigInteger result{ parseDigits(text) };
+    result.m_negative = negative;
+    result.normalize();
+    value = std::move(result);
+    return true;
+}
+
+InputReader& operator>>(InputReader& in, BigInteger& value)
+{
+    std::string_view text{ in.extractIntegerText() };
+    if (in.fail() || !parseBigInteger(text, value))
+        value = BigInteger{};
+
+    return in;
+}
+
+// Straight into the writer's buffer, without a string in between.
+OutputWriter& operator<<(OutputWriter& out, const BigInteger& value)
+{
+    char* first{ out.prepareWrite(decimalLengthBound(value)) };
+    out.commitWrite(static_cast<std::size_t>(writeDecimal(value, first) - first));
+    return out;
+}
+
+const char* bigIntegerImplementationName()
+{
+#ifdef LIMB_ARITHMETIC_HAS_ADC
+    return "adc";
+#else
+    return "portable";
+#endif
+}
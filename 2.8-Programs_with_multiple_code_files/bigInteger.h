@@ -0,0 +1,95 @@
+#ifndef BIG_INTEGER_H
+#define BIG_INTEGER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class InputReader;
+class OutputWriter;
+
+// An integer with as many digits as memory allows, for the numbers that lesson 1.5 shows an int can not hold:
+// "3000000000" extracted into an int becomes 2147483647, extracted into a BigInteger it stays 3000000000.
+// The magnitude is kept in 64-bit limbs, least significant first, with the sign kept separately. Adding and subtracting walk the limbs
+// once with the processor's add-with-carry instruction, so summing two million-digit numbers (about 52000 limbs each) takes microseconds.
+// Multiplying picks its method by size (see limbArithmetic.h): one pass for a small factor such as 2 or 3, schoolbook for short numbers,
+// then Karatsuba and Toom-3, which split the numbers and get by with fewer limb products than schoolbook's length squared.
+// Converting from and to decimal splits the number at powers of ten (10^19, 10^38, 10^76, ...) and converts the halves the same way,
+// so it costs a few of those multiplications instead of a pass over the whole number per 19 digits: a million digits take a fraction of a second.
+class BigInteger
+{
+public:
+    using Limb = unsigned long long; // The same as limbs::Limb in limbArithmetic.h.
+
+    BigInteger() = default;
+    BigInteger(long long value);
+
+    // The number with the given magnitude (least significant limb first; leading zero limbs are fine) and sign.
+    static BigInteger fromLimbs(std::vector<Limb> limbs, bool negative = false);
+
+    bool isNegative() const { return m_negative; }
+    bool isZero() const { return m_limbs.empty(); }
+
+    // The number of bits in the magnitude: 0 for zero, 1 for 1, 10 for 1000.
+    std::size_t bitLength() const;
+
+    // The magnitude, least significant limb first, without leading zero limbs (zero has none at all).
+    const std::vector<Limb>& limbs() const { return m_limbs; }
+
+    BigInteger& operator+=(const BigInteger& other);
+    BigInteger& operator-=(const BigInteger& other);
+    BigInteger& operator*=(const BigInteger& other);
+
+    friend BigInteger operator+(const BigInteger& x, const BigInteger& y);
+    friend BigInteger operator-(const BigInteger& x, const BigInteger& y);
+    friend BigInteger operator-(const BigInteger& x);
+    friend BigInteger operator*(const BigInteger& x, const BigInteger& y);
+
+    // Shift the magnitude and keep the sign, so that x >> 1 rounds toward zero.
+    friend BigInteger operator<<(const BigInteger& x, std::size_t bits);
+    friend BigInteger operator>>(const BigInteger& x, std::size_t bits);
+
+    // Negative, zero or positive as x is less than, equal to or greater than y.
+    friend int compare(const BigInteger& x, const BigInteger& y);
+
+    friend bool operator==(const BigInteger& x, const BigInteger& y) { return compare(x, y) == 0; }
+    friend bool operator!=(const BigInteger& x, const BigInteger& y) { return compare(x, y) != 0; }
+    friend bool operator<(const BigInteger& x, const BigInteger& y) { return compare(x, y) < 0; }
+    friend bool operator>(const BigInteger& x, const BigInteger& y) { return compare(x, y) > 0; }
+    friend bool operator<=(const BigInteger& x, const BigInteger& y) { return compare(x, y) <= 0; }
+    friend bool operator>=(const BigInteger& x, const BigInteger& y) { return compare(x, y) >= 0; }
+
+    std::string toString() const;
+
+private:
+    // Drops leading zero limbs, and the sign of zero.
+    void normalize();
+
+    // Sets this to x + y, with y taken as negative if yNegative. Either may be this number itself.
+    void assignSignedSum(const BigInteger& x, const BigInteger& y, bool yNegative);
+
+    // Set this to sign * (x + y) and sign * (x - y), for magnitudes x and y with x no smaller than y.
+    void assignSum(const std::vector<Limb>& x, const std::vector<Limb>& y, bool negative);
+    void assignDifference(const std::vector<Limb>& x, const std::vector<Limb>& y, bool negative);
+
+    friend bool parseBigInteger(std::string_view text, BigInteger& value);
+
+    std::vector<Limb> m_limbs{};
+    bool m_negative{ false };
+};
+
+// Reads a decimal integer: an optional '+' or '-', then one or more digits, and nothing else. Returns false (leaving value alone) if text is anything else.
+bool parseBigInteger(std::string_view text, BigInteger& value);
+
+// Extraction with the rules of InputReader's operator>>, except that no number is too big.
+// If no integer can be extracted, value is set to 0 and the reader goes into its fail state.
+InputReader& operator>>(InputReader& in, BigInteger& value);
+
+OutputWriter& operator<<(OutputWriter& out, const BigInteger& value);
+
+// Name of the carry loop the additions use ("adc" for the add-with-carry intrinsics, "portable" otherwise).
+const char* bigIntegerImplementationName();
+
+#endif
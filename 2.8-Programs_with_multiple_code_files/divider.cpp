@@ -0,0 +1,43 @@
+#include "divider.h"
+
+#include <cstddef>
+#include <cstdint>
+
+// Compiled once per instruction set; the dynamic loader picks the best one for this CPU.
+#if defined(__GNUC__) && defined(__x86_64__) && defined(__ELF__)
+#define DIVIDER_KERNEL __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define DIVIDER_KERNEL
+#endif
+
+namespace arithmetic
+{
+    // The divider arrives by value: a copy in registers cannot alias out, so the compiler keeps its fields out of the loop.
+    DIVIDER_KERNEL
+    void divide(const std::uint32_t* in, std::uint32_t* out, std::size_t count, UnsignedDivider divider)
+    {
+        for (std::size_t i{ 0 }; i < count; ++i)
+            out[i] = divider.divide(in[i]);
+    }
+
+    DIVIDER_KERNEL
+    void remainder(const std::uint32_t* in, std::uint32_t* out, std::size_t count, UnsignedDivider divider)
+    {
+        for (std::size_t i{ 0 }; i < count; ++i)
+            out[i] = divider.remainder(in[i]);
+    }
+
+    DIVIDER_KERNEL
+    void divide(const std::int32_t* in, std::int32_t* out, std::size_t count, SignedDivider divider)
+    {
+        for (std::size_t i{ 0 }; i < count; ++i)
+            out[i] = divider.divide(in[i]);
+    }
+
+    DIVIDER_KERNEL
+    void remainder(const std::int32_t* in, std::int32_t* out, std::size_t count, SignedDivider divider)
+    {
+        for (std::size_t i{ 0 }; i < count; ++i)
+            out[i] = divider.remainder(in[i]);
+    }
+}
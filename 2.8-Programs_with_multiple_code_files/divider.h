@@ -0,0 +1,153 @@
+#ifndef DIVIDER_H
+#define DIVIDER_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Division by a divisor that is only known at run time, but stays the same for a whole column of numbers.
+// The division instruction takes 20 to 90 cycles and cannot be vectorized: there is no SIMD integer division. Dividing by a constant,
+// the compiler instead multiplies by a precomputed "magic" number close to 2^32 / divisor, keeps the high half of the product, and shifts
+// (Granlund and Montgomery, "Division by invariant integers using multiplication"). A divider does the same work once, when it is made,
+// so that every division after that is a multiply-high, a few adds and shifts, all of which have SIMD forms.
+// The results are exactly those of / and %, rounding toward zero, for every value. The divisor must not be 0.
+namespace arithmetic
+{
+    class UnsignedDivider
+    {
+    public:
+        constexpr explicit UnsignedDivider(std::uint32_t divisor)
+            : m_divisor{ divisor }
+        {
+            if (divisor == 1)
+                return; // x / 1 is x: a multiplier and shifts of 0 get there.
+
+            // With l = ceil(log2(divisor)), the multiplier 2^32 + m is the smallest that is at least 2^(32 + l) / divisor.
+            // That needs 33 bits, so divide() adds the 2^32 * x part itself, halving on the way so that the sum cannot overflow.
+            unsigned l{ 0 };
+            while (l < 32 && (std::uint64_t{ 1 } << l) < divisor)
+                ++l;
+
+            std::uint64_t excess{ (std::uint64_t{ 1 } << l) - divisor };
+            m_multiplier = static_cast<std::uint32_t>((excess << 32) / divisor + 1);
+            m_shift1 = 1;
+            m_shift2 = l - 1;
+        }
+
+        constexpr std::uint32_t divisor() const { return m_divisor; }
+
+        constexpr std::uint32_t divide(std::uint32_t x) const
+        {
+            std::uint32_t high{ static_cast<std::uint32_t>((static_cast<std::uint64_t>(x) * m_multiplier) >> 32) };
+            return (high + ((x - high) >> m_shift1)) >> m_shift2;
+        }
+
+        constexpr std::uint32_t remainder(std::uint32_t x) const { return x - divide(x) * m_divisor; }
+
+    private:
+        std::uint32_t m_divisor{};
+        std::uint32_t m_multiplier{ 0 };
+        unsigned m_shift1{ 0 };
+        unsigned m_shift2{ 0 };
+    };
+
+    // Like int32_t's own / and %, except that the one quotient that does not fit, the smallest int32_t / -1, wraps around to itself
+    // (as arithmetic::Wrap would), and its remainder is 0.
+    class SignedDivider
+    {
+    public:
+        constexpr explicit SignedDivider(std::int32_t divisor)
+            : m_divisor{ divisor }
+        {
+            // The magnitude, as unsigned, so that the smallest int32_t has one too.
+            std::uint32_t magnitude{ divisor < 0 ? 0 - static_cast<std::uint32_t>(divisor) : static_cast<std::uint32_t>(divisor) };
+            m_negate = divisor < 0 ? -1 : 0;
+
+            if (magnitude == 1)
+            {
+                // x / 1 is x, and x / -1 is -x: nothing to multiply, just the added (or subtracted) x, and no rounding to correct.
+                m_addMask = -1;
+                return;
+            }
+
+            // Hacker's Delight, section 10-4: the smallest multiplier with 2^(32 + shift) / magnitude close enough to the exact quotient
+            // for every int32_t, found by stepping the shift up from 32, with the quotients and remainders of 2^p by the divisor
+            // and by the largest multiple of it less one that a dividend can reach.
+            constexpr std::uint32_t two31{ std::uint32_t{ 1 } << 31 };
+            std::uint32_t t{ two31 + (static_cast<std::uint32_t>(divisor) >> 31) };
+            std::uint32_t reachable{ t - 1 - t % magnitude };
+            std::uint32_t q1{ two31 / reachable };
+            std::uint32_t r1{ two31 - q1 * reachable };
+            std::uint32_t q2{ two31 / magnitude };
+            std::uint32_t r2{ two31 - q2 * magnitude };
+            int p{ 31 };
+            std::uint32_t delta{};
+            do
+            {
+                ++p;
+                q1 *= 2;
+                r1 *= 2;
+                if (r1 >= reachable)
+                {
+                    ++q1;
+                    r1 -= reachable;
+                }
+
+                q2 *= 2;
+                r2 *= 2;
+                if (r2 >= magnitude)
+                {
+                    ++q2;
+                    r2 -= magnitude;
+                }
+
+                delta = magnitude - r2;
+            } while (q1 < delta || (q1 == delta && r1 == 0));
+
+            std::uint32_t multiplier{ q2 + 1 };
+            m_multiplier = static_cast<std::int32_t>(divisor < 0 ? 0 - multiplier : multiplier);
+            m_shift = static_cast<unsigned>(p - 32);
+
+            // A multiplier that came out with the wrong sign for the divisor is really 2^32 away from the one wanted: x makes up the difference.
+            if ((divisor > 0 && m_multiplier < 0) || (divisor < 0 && m_multiplier > 0))
+                m_addMask = -1;
+
+            m_roundMask = 1;
+        }
+
+        constexpr std::int32_t divisor() const { return m_divisor; }
+
+        constexpr std::int32_t divide(std::int32_t x) const
+        {
+            // The high half of the product, plus or minus x (or nothing), shifted: this rounds toward minus infinity,
+            // so a negative quotient gets 1 added (the shifted-out sign bit) to round it toward zero instead.
+            // The masks take the place of branches on the divisor, so that the same instructions run for every divisor.
+            std::int32_t high{ static_cast<std::int32_t>((static_cast<std::int64_t>(x) * m_multiplier) >> 32) };
+            std::uint32_t signedX{ (static_cast<std::uint32_t>(x) ^ static_cast<std::uint32_t>(m_negate)) - static_cast<std::uint32_t>(m_negate) };
+            std::uint32_t sum{ static_cast<std::uint32_t>(high) + (signedX & static_cast<std::uint32_t>(m_addMask)) };
+            std::int32_t quotient{ static_cast<std::int32_t>(sum) >> m_shift };
+            return static_cast<std::int32_t>(static_cast<std::uint32_t>(quotient) + ((static_cast<std::uint32_t>(quotient) >> 31) & m_roundMask));
+        }
+
+        constexpr std::int32_t remainder(std::int32_t x) const
+        {
+            return static_cast<std::int32_t>(static_cast<std::uint32_t>(x) - static_cast<std::uint32_t>(divide(x)) * static_cast<std::uint32_t>(m_divisor));
+        }
+
+    private:
+        std::int32_t m_divisor{};
+        std::int32_t m_multiplier{ 0 };
+        std::int32_t m_negate{ 0 };  // -1 for a negative divisor, to negate x with (x ^ -1) - -1.
+        std::int32_t m_addMask{ 0 }; // -1 where x is added to the high half.
+        std::uint32_t m_roundMask{ 0 };
+        unsigned m_shift{ 0 };
+    };
+
+    // out[i] = in[i] / divider.divisor() and in[i] % divider.divisor() for i in [0, count). out may be the same array as in.
+    // Compiled for SSE2, AVX2 and AVX-512 like scale(), where the multiply-high is vpmuludq (vpmuldq for signed) on 2, 4 or 8 lanes at a time.
+    void divide(const std::uint32_t* in, std::uint32_t* out, std::size_t count, UnsignedDivider divider);
+    void remainder(const std::uint32_t* in, std::uint32_t* out, std::size_t count, UnsignedDivider divider);
+    void divide(const std::int32_t* in, std::int32_t* out, std::size_t count, SignedDivider divider);
+    void remainder(const std::int32_t* in, std::int32_t* out, std::size_t count, SignedDivider divider);
+}
+
+#endif
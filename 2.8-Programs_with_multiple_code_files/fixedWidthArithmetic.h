@@ -0,0 +1,360 @@
+#ifndef FIXED_WIDTH_ARITHMETIC_H
+#define FIXED_WIDTH_ARITHMETIC_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+// Integer add, sub and mul over the fixed-width types from lesson 4.6, with the overflow behavior picked at compile time:
+//     arithmetic::add<arithmetic::Saturate>(x, y)
+// Policies:
+//     Unchecked: plain C++ arithmetic. Overflow is asserted against in debug builds and is undefined behavior in release builds, exactly like x + y.
+//     Wrap:      wraps around modulo 2^N (two's complement), like the unsigned types do.
+//     Saturate:  clamps to the smallest/largest value of the type (e.g. 2147483647 instead of wrapping to a negative number).
+//     Checked:   wraps, and reports whether the result overflowed.
+//     Widen:     returns the next wider type (std::int32_t -> std::int64_t), so the result can never overflow.
+// Every operation also comes in a batch form over arrays, written branch-free so the compiler can vectorize it.
+namespace arithmetic
+{
+    template <typename T>
+    inline constexpr bool isFixedWidthInteger{
+        std::is_same_v<T, std::int8_t> || std::is_same_v<T, std::uint8_t> ||
+        std::is_same_v<T, std::int16_t> || std::is_same_v<T, std::uint16_t> ||
+        std::is_same_v<T, std::int32_t> || std::is_same_v<T, std::uint32_t> ||
+        std::is_same_v<T, std::int64_t> || std::is_same_v<T, std::uint64_t> };
+
+    template <typename T>
+    struct Wider;
+
+    template <> struct Wider<std::int8_t> { using type = std::int16_t; };
+    template <> struct Wider<std::uint8_t> { using type = std::uint16_t; };
+    template <> struct Wider<std::int16_t> { using type = std::int32_t; };
+    template <> struct Wider<std::uint16_t> { using type = std::uint32_t; };
+    template <> struct Wider<std::int32_t> { using type = std::int64_t; };
+    template <> struct Wider<std::uint32_t> { using type = std::uint64_t; };
+#ifdef __SIZEOF_INT128__
+    template <> struct Wider<std::int64_t> { using type = __int128; };
+    template <> struct Wider<std::uint64_t> { using type = unsigned __int128; };
+#endif
+
+    template <typename T>
+    using WiderType = typename Wider<T>::type;
+
+    // The result of a Checked operation: the wrapped value, and whether it had to wrap.
+    template <typename T>
+    struct CheckedValue
+    {
+        T value{};
+        bool overflow{};
+    };
+
+    namespace detail
+    {
+        // Unsigned type used to do the arithmetic. It is at least as wide as unsigned int, because std::uint16_t * std::uint16_t would otherwise be promoted to (signed) int and could overflow.
+        template <typename T>
+        using Unsigned = std::conditional_t<(sizeof(T) < sizeof(unsigned)), unsigned, std::make_unsigned_t<T>>;
+
+        template <typename T>
+        constexpr T wrappingAdd(T x, T y)
+        {
+            return static_cast<T>(static_cast<Unsigned<T>>(x) + static_cast<Unsigned<T>>(y));
+        }
+
+        template <typename T>
+        constexpr T wrappingSub(T x, T y)
+        {
+            return static_cast<T>(static_cast<Unsigned<T>>(x) - static_cast<Unsigned<T>>(y));
+        }
+
+        template <typename T>
+        constexpr T wrappingMul(T x, T y)
+        {
+            return static_cast<T>(static_cast<Unsigned<T>>(x) * static_cast<Unsigned<T>>(y));
+        }
+
+        // The overflow tests below only use the wrapped result and bit operations, so they stay branch-free.
+        template <typename T>
+        constexpr bool addOverflows(T x, T y, T& wrapped)
+        {
+            wrapped = wrappingAdd(x, y);
+
+            if constexpr (std::is_signed_v<T>)
+                return static_cast<T>((x ^ wrapped) & (y ^ wrapped)) < 0; // Both operands have the other sign than the result.
+            else
+                return wrapped < x;
+        }
+
+        template <typename T>
+        constexpr bool subOverflows(T x, T y, T& wrapped)
+        {
+            wrapped = wrappingSub(x, y);
+
+            if constexpr (std::is_signed_v<T>)
+                return static_cast<T>((x ^ y) & (x ^ wrapped)) < 0; // Operands differ in sign, and the result lost x's sign.
+            else
+                return x < y;
+        }
+
+        template <typename T>
+        constexpr bool mulOverflows(T x, T y, T& wrapped)
+        {
+            wrapped = wrappingMul(x, y);
+
+            if constexpr (sizeof(T) < sizeof(std::int64_t))
+            {
+                // The exact product always fits in the next wider type.
+                WiderType<T> exact{ static_cast<WiderType<T>>(static_cast<WiderType<T>>(x) * static_cast<WiderType<T>>(y)) };
+                return exact < std::numeric_limits<T>::min() || exact > std::numeric_limits<T>::max();
+            }
+            else
+            {
+#if defined(__GNUC__)
+                T ignored{};
+                return __builtin_mul_overflow(x, y, &ignored);
+#else
+                if (x == 0 || y == 0)
+                    return false;
+                if constexpr (std::is_signed_v<T>)
+                {
+                    if ((x == -1 && y == std::numeric_limits<T>::min()) || (y == -1 && x == std::numeric_limits<T>::min()))
+                        return true;
+                }
+                return wrapped / y != x;
+#endif
+            }
+        }
+
+        template <typename T>
+        constexpr T select(bool condition, T ifTrue, T ifFalse)
+        {
+            return condition ? ifTrue : ifFalse;
+        }
+    }
+
+    struct Unchecked
+    {
+        template <typename T> using Result = T;
+        template <typename T> using Element = T;
+
+        template <typename T>
+        static constexpr T add(T x, T y)
+        {
+            [[maybe_unused]] T wrapped{};
+            assert(!detail::addOverflows(x, y, wrapped) && "Unchecked add overflowed");
+            return static_cast<T>(x + y);
+        }
+
+        template <typename T>
+        static constexpr T sub(T x, T y)
+        {
+            [[maybe_unused]] T wrapped{};
+            assert(!detail::subOverflows(x, y, wrapped) && "Unchecked sub overflowed");
+            return static_cast<T>(x - y);
+        }
+
+        template <typename T>
+        static constexpr T mul(T x, T y)
+        {
+            [[maybe_unused]] T wrapped{};
+            assert(!detail::mulOverflows(x, y, wrapped) && "Unchecked mul overflowed");
+            return static_cast<T>(x * y);
+        }
+
+        template <typename T> static constexpr T addElement(T x, T y, unsigned&) { return add(x, y); }
+        template <typename T> static constexpr T subElement(T x, T y, unsigned&) { return sub(x, y); }
+        template <typename T> static constexpr T mulElement(T x, T y, unsigned&) { return mul(x, y); }
+    };
+
+    struct Wrap
+    {
+        template <typename T> using Result = T;
+        template <typename T> using Element = T;
+
+        template <typename T> static constexpr T add(T x, T y) { return detail::wrappingAdd(x, y); }
+        template <typename T> static constexpr T sub(T x, T y) { return detail::wrappingSub(x, y); }
+        template <typename T> static constexpr T mul(T x, T y) { return detail::wrappingMul(x, y); }
+
+        template <typename T> static constexpr T addElement(T x, T y, unsigned&) { return add(x, y); }
+        template <typename T> static constexpr T subElement(T x, T y, unsigned&) { return sub(x, y); }
+        template <typename T> static constexpr T mulElement(T x, T y, unsigned&) { return mul(x, y); }
+    };
+
+    struct Saturate
+    {
+        template <typename T> using Result = T;
+        template <typename T> using Element = T;
+
+        template <typename T>
+        static constexpr T add(T x, T y)
+        {
+            T wrapped{};
+            bool overflow{ detail::addOverflows(x, y, wrapped) };
+
+            // Signed addition can only overflow when both operands have the same sign, so x's sign tells us which end we went past.
+            if constexpr (std::is_signed_v<T>)
+                return detail::select(overflow, x < 0 ? std::numeric_limits<T>::min() : std::numeric_limits<T>::max(), wrapped);
+            else
+                return detail::select(overflow, std::numeric_limits<T>::max(), wrapped);
+        }
+
+        template <typename T>
+        static constexpr T sub(T x, T y)
+        {
+            T wrapped{};
+            bool overflow{ detail::subOverflows(x, y, wrapped) };
+
+            if constexpr (std::is_signed_v<T>)
+                return detail::select(overflow, x < 0 ? std::numeric_limits<T>::min() : std::numeric_limits<T>::max(), wrapped);
+            else
+                return detail::select(overflow, T{ 0 }, wrapped);
+        }
+
+        template <typename T>
+        static constexpr T mul(T x, T y)
+        {
+            T wrapped{};
+            bool overflow{ detail::mulOverflows(x, y, wrapped) };
+
+            if constexpr (std::is_signed_v<T>)
+                return detail::select(overflow, (x < 0) != (y < 0) ? std::numeric_limits<T>::min() : std::numeric_limits<T>::max(), wrapped);
+            else
+                return detail::select(overflow, std::numeric_limits<T>::max(), wrapped);
+        }
+
+        template <typename T> static constexpr T addElement(T x, T y, unsigned&) { return add(x, y); }
+        template <typename T> static constexpr T subElement(T x, T y, unsigned&) { return sub(x, y); }
+        template <typename T> static constexpr T mulElement(T x, T y, unsigned&) { return mul(x, y); }
+    };
+
+    struct Checked
+    {
+        template <typename T> using Result = CheckedValue<T>;
+        template <typename T> using Element = T;
+
+        template <typename T>
+        static constexpr CheckedValue<T> add(T x, T y)
+        {
+            CheckedValue<T> result{};
+            result.overflow = detail::addOverflows(x, y, result.value);
+            return result;
+        }
+
+        template <typename T>
+        static constexpr CheckedValue<T> sub(T x, T y)
+        {
+            CheckedValue<T> result{};
+            result.overflow = detail::subOverflows(x, y, result.value);
+            return result;
+        }
+
+        template <typename T>
+        static constexpr CheckedValue<T> mul(T x, T y)
+        {
+            CheckedValue<T> result{};
+            result.overflow = detail::mulOverflows(x, y, result.value);
+            return result;
+        }
+
+        // In the batch form the overflow flags are OR-ed into one accumulator instead of being stored per element.
+        template <typename T>
+        static constexpr T addElement(T x, T y, unsigned& overflow)
+        {
+            T wrapped{};
+            overflow |= static_cast<unsigned>(detail::addOverflows(x, y, wrapped));
+            return wrapped;
+        }
+
+        template <typename T>
+        static constexpr T subElement(T x, T y, unsigned& overflow)
+        {
+            T wrapped{};
+            overflow |= static_cast<unsigned>(detail::subOverflows(x, y, wrapped));
+            return wrapped;
+        }
+
+        template <typename T>
+        static constexpr T mulElement(T x, T y, unsigned& overflow)
+        {
+            T wrapped{};
+            overflow |= static_cast<unsigned>(detail::mulOverflows(x, y, wrapped));
+            return wrapped;
+        }
+    };
+
+    struct Widen
+    {
+        template <typename T> using Result = WiderType<T>;
+        template <typename T> using Element = WiderType<T>;
+
+        template <typename T> static constexpr WiderType<T> add(T x, T y) { return static_cast<WiderType<T>>(static_cast<WiderType<T>>(x) + static_cast<WiderType<T>>(y)); }
+        template <typename T> static constexpr WiderType<T> sub(T x, T y) { return static_cast<WiderType<T>>(static_cast<WiderType<T>>(x) - static_cast<WiderType<T>>(y)); }
+        template <typename T> static constexpr WiderType<T> mul(T x, T y) { return static_cast<WiderType<T>>(static_cast<WiderType<T>>(x) * static_cast<WiderType<T>>(y)); }
+
+        template <typename T> static constexpr WiderType<T> addElement(T x, T y, unsigned&) { return add(x, y); }
+        template <typename T> static constexpr WiderType<T> subElement(T x, T y, unsigned&) { return sub(x, y); }
+        template <typename T> static constexpr WiderType<T> mulElement(T x, T y, unsigned&) { return mul(x, y); }
+    };
+
+    template <typename Policy, typename T>
+    constexpr typename Policy::template Result<T> add(T x, T y)
+    {
+        static_assert(isFixedWidthInteger<T>, "arithmetic::add only works on the std::intN_t / std::uintN_t types");
+        return Policy::add(x, y);
+    }
+
+    template <typename Policy, typename T>
+    constexpr typename Policy::template Result<T> sub(T x, T y)
+    {
+        static_assert(isFixedWidthInteger<T>, "arithmetic::sub only works on the std::intN_t / std::uintN_t types");
+        return Policy::sub(x, y);
+    }
+
+    template <typename Policy, typename T>
+    constexpr typename Policy::template Result<T> mul(T x, T y)
+    {
+        static_assert(isFixedWidthInteger<T>, "arithmetic::mul only works on the std::intN_t / std::uintN_t types");
+        return Policy::mul(x, y);
+    }
+
+    // Batch forms: out[i] = a[i] op b[i] for i in [0, count). out may be the same array as a or b.
+    // They return true if any element overflowed. Only the Checked policy tracks this; the others always return false.
+    template <typename Policy, typename T>
+    bool add(const T* a, const T* b, typename Policy::template Element<T>* out, std::size_t count)
+    {
+        static_assert(isFixedWidthInteger<T>, "arithmetic::add only works on the std::intN_t / std::uintN_t types");
+
+        unsigned overflow{ 0 };
+        for (std::size_t i{ 0 }; i < count; ++i)
+            out[i] = Policy::addElement(a[i], b[i], overflow);
+
+        return overflow != 0;
+    }
+
+    template <typename Policy, typename T>
+    bool sub(const T* a, const T* b, typename Policy::template Element<T>* out, std::size_t count)
+    {
+        static_assert(isFixedWidthInteger<T>, "arithmetic::sub only works on the std::intN_t / std::uintN_t types");
+
+        unsigned overflow{ 0 };
+        for (std::size_t i{ 0 }; i < count; ++i)
+            out[i] = Policy::subElement(a[i], b[i], overflow);
+
+        return overflow != 0;
+    }
+
+    template <typename Policy, typename T>
+    bool mul(const T* a, const T* b, typename Policy::template Element<T>* out, std::size_t count)
+    {
+        static_assert(isFixedWidthInteger<T>, "arithmetic::mul only works on the std::intN_t / std::uintN_t types");
+
+        unsigned overflow{ 0 };
+        for (std::size_t i{ 0 }; i < count; ++i)
+            out[i] = Policy::mulElement(a[i], b[i], overflow);
+
+        return overflow != 0;
+    }
+}
+
+#endif
@@ -1,12 +1,16 @@
-#include <string>
-#include <iostream>
+#include "getInputWithNote.h"
 
-int getInputWithNote(std::string content)
+#include <string_view>
+
+#include "inputReader.h"
+#include "outputWriter.h"
+
+int getInputWithNote(std::string_view content)
 {
     int input{};
 
-    std::cout << content;
-    std::cin >> input;
+    standardOutput() << content;
+    standardInput() >> input;
 
     return input;
-}
\ No newline at end of file
+}
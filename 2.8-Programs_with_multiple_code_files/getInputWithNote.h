@@ -0,0 +1,9 @@
+#ifndef GET_INPUT_WITH_NOTE_H
+#define GET_INPUT_WITH_NOTE_H
+
+#include <string_view>
+
+// Prints content as a prompt, then extracts one integer from standard input.
+int getInputWithNote(std::string_view content);
+
+#endif
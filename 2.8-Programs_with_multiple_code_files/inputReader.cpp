@@ -0,0 +1,434 @@
+#include "inputReader.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define INPUT_READER_HAS_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+    bool isWhitespace(char c)
+    {
+        // The same characters std::isspace accepts in the "C" locale: ' ', '\t', '\n', '\v', '\f', '\r'.
+        return c == ' ' || static_cast<unsigned char>(c - '\t') <= '\r' - '\t';
+    }
+
+    bool isDigit(char c)
+    {
+        return static_cast<unsigned char>(c - '0') <= 9;
+    }
+
+#ifdef INPUT_READER_HAS_SSE2
+    // Bit i is set if byte i of the 16 bytes is whitespace.
+    unsigned whitespaceMask(__m128i bytes)
+    {
+        __m128i space{ _mm_cmpeq_epi8(bytes, _mm_set1_epi8(' ')) };
+
+        // '\t'..'\r' is a range of 5 values. Shifting it down to start at -128 turns the range check into one signed compare.
+        __m128i shifted{ _mm_sub_epi8(bytes, _mm_set1_epi8(static_cast<char>('\t' - 128))) };
+        __m128i control{ _mm_cmplt_epi8(shifted, _mm_set1_epi8(static_cast<char>(-128 + 5))) };
+
+        return static_cast<unsigned>(_mm_movemask_epi8(_mm_or_si128(space, control)));
+    }
+
+    unsigned digitMask(__m128i bytes)
+    {
+        __m128i shifted{ _mm_sub_epi8(bytes, _mm_set1_epi8(static_cast<char>('0' - 128))) };
+        return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmplt_epi8(shifted, _mm_set1_epi8(static_cast<char>(-128 + 10)))));
+    }
+
+    int countTrailingZeros(unsigned mask)
+    {
+#if defined(__GNUC__)
+        return __builtin_ctz(mask);
+#else
+        int count{ 0 };
+        while ((mask & 1u) == 0)
+        {
+            mask >>= 1;
+            ++count;
+        }
+        return count;
+#endif
+    }
+#endif
+
+    // Returns the first non-whitespace character in [first, last), or last.
+    const char* findNonWhitespace(const char* first, const char* last)
+    {
+#ifdef INPUT_READER_HAS_SSE2
+        for (; last - first >= 16; first += 16)
+        {
+            unsigned others{ ~whitespaceMask(_mm_loadu_si128(reinterpret_cast<const __m128i*>(first))) & 0xFFFFu };
+            if (others != 0)
+                return first + countTrailingZeros(others);
+        }
+#endif
+        while (first != last && isWhitespace(*first))
+            ++first;
+
+        return first;
+    }
+
+    // Returns the first character in [first, last) that is not a digit, or last.
+    const char* findNonDigit(const char* first, const char* last)
+    {
+#ifdef INPUT_READER_HAS_SSE2
+        for (; last - first >= 16; first += 16)
+        {
+            unsigned others{ ~digitMask(_mm_loadu_si128(reinterpret_cast<const __m128i*>(first))) & 0xFFFFu };
+            if (others != 0)
+                return first + countTrailingZeros(others);
+        }
+#endif
+        while (first != last && isDigit(*first))
+            ++first;
+
+        return first;
+    }
+
+    // Up to 19 digits always fit in an unsigned long long, so their value can be accumulated without any overflow check.
+    constexpr std::ptrdiff_t maxDigitsWithoutOverflow{ 19 };
+
+    // Converts the digits in [first, last). Short runs (the common case) take a plain loop, since we already know where the digits end; longer runs go through std::from_chars for its overflow detection.
+    bool parseDigits(const char* first, const char* last, unsigned long long& value)
+    {
+        if (last - first <= maxDigitsWithoutOverflow)
+        {
+            unsigned long long result{ 0 };
+            for (; first != last; ++first)
+                result = result * 10 + static_cast<unsigned>(*first - '0');
+
+            value = result;
+            return true;
+        }
+
+        return std::from_chars(first, last, value).ec != std::errc::result_out_of_range;
+    }
+
+    // The powers of ten a double holds exactly: 5^22 still fits in its 53 bits.
+    constexpr double exactPowersOfTen[]{ 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                         1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+    constexpr int maxExactPowerOfTen{ 22 };
+
+    // Whole numbers up to 2^53 are exact in a double.
+    constexpr std::uint64_t maxExactMantissa{ std::uint64_t{ 1 } << 53 };
+
+    // Adds the digits starting at first to mantissa and returns the end of them. Past 19 digits the mantissa wraps around, which
+    // the caller notices from the count: it only trusts the mantissa for 19 digits or fewer.
+    const char* accumulateDigits(const char* first, const char* last, std::uint64_t& mantissa)
+    {
+        for (; first != last && isDigit(*first); ++first)
+            mantissa = mantissa * 10 + static_cast<unsigned>(*first - '0');
+
+        return first;
+    }
+
+    long long readFromDescriptor(int fileDescriptor, char* buffer, std::size_t size)
+    {
+#if defined(_WIN32)
+        return _read(fileDescriptor, buffer, static_cast<unsigned>(size));
+#else
+        return static_cast<long long>(read(fileDescriptor, buffer, size));
+#endif
+    }
+}
+
+InputReader::InputReader(int fileDescriptor, OutputWriter* tied, std::size_t blockSize)
+    : m_fileDescriptor{ fileDescriptor }, m_buffer(blockSize), m_tied{ tied }
+{
+    m_position = m_buffer.data();
+    m_end = m_buffer.data();
+}
+
+InputReader::InputReader(const char* first, const char* last)
+    : m_fileDescriptor{ -1 }, m_position{ first }, m_end{ last }, m_eof{ true }
+{
+}
+
+bool InputReader::refill()
+{
+    if (m_eof)
+        return false;
+
+    if (m_tied)
+        m_tied->flush();
+
+    // Keep the unread part, moved to the front. If it already fills the whole buffer (a very long token), make the buffer bigger.
+    std::size_t kept{ static_cast<std::size_t>(m_end - m_position) };
+    std::memmove(m_buffer.data(), m_position, kept);
+    if (kept == m_buffer.size())
+        m_buffer.resize(m_buffer.size() * 2);
+
+    long long received{ readFromDescriptor(m_fileDescriptor, m_buffer.data() + kept, m_buffer.size() - kept) };
+    if (received <= 0)
+    {
+        m_eof = true;
+        received = 0;
+    }
+
+    m_position = m_buffer.data();
+    m_end = m_buffer.data() + kept + received;
+    return received > 0;
+}
+
+bool InputReader::skipWhitespace()
+{
+    while (true)
+    {
+        m_position = findNonWhitespace(m_position, m_end);
+        if (m_position != m_end)
+            return true;
+
+        if (!refill())
+            return false;
+    }
+}
+
+const char* InputReader::tokenEnd()
+{
+    // Offsets instead of pointers, because refill() may move the buffer.
+    std::size_t scanned{ 0 };
+
+    while (true)
+    {
+        const char* first{ m_position + scanned };
+        if (scanned == 0 && first != m_end && (*first == '+' || *first == '-'))
+            ++first;
+
+        const char* end{ findNonDigit(first, m_end) };
+        if (end != m_end || m_eof)
+            return end;
+
+        // The digits run up to the end of the block, so the number may continue in the next one.
+        scanned = static_cast<std::size_t>(end - m_position);
+        if (!refill())
+            return m_end;
+    }
+}
+
+bool InputReader::extractSigned(long long& value, long long min, long long max)
+{
+    unsigned long long magnitude{};
+    bool negative{ false };
+
+    if (m_fail)
+        return false;
+
+    if (!skipWhitespace())
+    {
+        m_fail = true;
+        value = 0;
+        return true;
+    }
+
+    const char* end{ tokenEnd() };
+    const char* digits{ m_position };
+    if (*digits == '+' || *digits == '-')
+    {
+        negative = *digits == '-';
+        ++digits;
+    }
+
+    if (digits == end)
+    {
+        // Nothing valid to extract (e.g. "abc123", or a lone "-"). Leave the input where it is.
+        m_fail = true;
+        value = 0;
+        return true;
+    }
+
+    bool fits{ parseDigits(digits, end, magnitude) };
+    m_position = end;
+
+    unsigned long long limit{ negative ? 0ull - static_cast<unsigned long long>(min) : static_cast<unsigned long long>(max) };
+    if (!fits || magnitude > limit)
+    {
+        m_fail = true;
+        value = negative ? min : max;
+        return true;
+    }
+
+    value = negative ? static_cast<long long>(0ull - magnitude) : static_cast<long long>(magnitude);
+    return true;
+}
+
+bool InputReader::extractUnsigned(unsigned long long& value, unsigned long long max)
+{
+    if (m_fail)
+        return false;
+
+    if (!skipWhitespace())
+    {
+        m_fail = true;
+        value = 0;
+        return true;
+    }
+
+    const char* end{ tokenEnd() };
+    const char* digits{ m_position };
+    if (*digits == '+')
+        ++digits;
+
+    if (digits == end || *digits == '-')
+    {
+        m_fail = true;
+        value = 0;
+        return true;
+    }
+
+    bool fits{ parseDigits(digits, end, value) };
+    m_position = end;
+
+    if (!fits || value > max)
+    {
+        m_fail = true;
+        value = max;
+    }
+
+    return true;
+}
+
+std::string_view InputReader::extractIntegerText()
+{
+    if (m_fail)
+        return {};
+
+    if (!skipWhitespace())
+    {
+        m_fail = true;
+        return {};
+    }
+
+    const char* end{ tokenEnd() };
+    const char* digits{ m_position };
+    if (*digits == '+' || *digits == '-')
+        ++digits;
+
+    if (digits == end)
+    {
+        m_fail = true;
+        return {};
+    }
+
+    std::string_view text{ m_position, static_cast<std::size_t>(end - m_position) };
+    m_position = end;
+    return text;
+}
+
+void InputReader::ignoreLine()
+{
+    while (true)
+    {
+        const char* newline{ static_cast<const char*>(std::memchr(m_position, '\n', static_cast<std::size_t>(m_end - m_position))) };
+        if (newline)
+        {
+            m_position = newline + 1;
+            return;
+        }
+
+        m_position = m_end;
+        if (!refill())
+            return;
+    }
+}
+
+InputReader& standardInput()
+{
+    static InputReader reader{ 0, &standardOutput() };
+    return reader;
+}
+
+std::from_chars_result parseFloatingPoint(const char* first, const char* last, double& value)
+{
+    const char* current{ first };
+    bool negative{ current != last && *current == '-' };
+    if (negative)
+        ++current;
+
+    std::uint64_t mantissa{ 0 };
+    const char* integerDigits{ current };
+    current = accumulateDigits(current, last, mantissa);
+    std::ptrdiff_t digits{ current - integerDigits };
+
+    // The digits after the point count the same, and make the exponent smaller.
+    int exponent{ 0 };
+    if (current != last && *current == '.')
+    {
+        const char* fractionDigits{ ++current };
+        current = accumulateDigits(current, last, mantissa);
+        digits += current - fractionDigits;
+        exponent = -static_cast<int>(current - fractionDigits);
+    }
+
+    // No digits ("inf", "nan", ".", "-x") or more than 19 (with leading zeros too, which is rare): std::from_chars sorts it out.
+    if (digits == 0 || digits > 19)
+        return std::from_chars(first, last, value);
+
+    // An exponent without digits after it ("2e", "2e+") is not part of the number.
+    if (current != last && (*current == 'e' || *current == 'E'))
+    {
+        const char* exponentDigits{ current + 1 };
+        bool negativeExponent{ exponentDigits != last && *exponentDigits == '-' };
+        if (exponentDigits != last && (*exponentDigits == '-' || *exponentDigits == '+'))
+            ++exponentDigits;
+
+        std::uint64_t written{ 0 };
+        const char* end{ accumulateDigits(exponentDigits, last, written) };
+        if (end != exponentDigits)
+        {
+            // Exponents this far out are certain to be out of range, or to need a more careful look.
+            if (end - exponentDigits > 4)
+                return std::from_chars(first, last, value);
+
+            exponent += negativeExponent ? -static_cast<int>(written) : static_cast<int>(written);
+            current = end;
+        }
+    }
+
+    // With both the mantissa and the power of ten exact, the one multiplication or division rounds the exact quotient correctly.
+    // A little past 10^22 still works when the rest of the power fits in the mantissa: 12e30 is 12000000 * 10^22.
+    double result{};
+    if (mantissa == 0)
+        result = 0.0;
+    else if (mantissa <= maxExactMantissa && exponent >= -maxExactPowerOfTen && exponent <= maxExactPowerOfTen)
+        result = exponent < 0 ? static_cast<double>(mantissa) / exactPowersOfTen[-exponent] : static_cast<double>(mantissa) * exactPowersOfTen[exponent];
+    else if (mantissa <= maxExactMantissa && exponent > maxExactPowerOfTen && exponent <= maxExactPowerOfTen + 15)
+    {
+        for (; exponent > maxExactPowerOfTen && mantissa <= maxExactMantissa; --exponent)
+            mantissa *= 10;
+
+        if (mantissa > maxExactMantissa)
+            return std::from_chars(first, last, value);
+
+        result = static_cast<double>(mantissa) * exactPowersOfTen[exponent];
+    }
+    else
+        return std::from_chars(first, last, value);
+
+    value = negative ? -result : result;
+    return { current, std::errc{} };
+}
+
+double outOfRangeValue(const char* first, const char* last)
+{
+    // std::strtod needs the number null-terminated. Numbers out of range are rare enough that the copy does not matter.
+    std::string number(first, last);
+    return std::strtod(number.c_str(), nullptr);
+}
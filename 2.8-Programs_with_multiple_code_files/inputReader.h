@@ -0,0 +1,108 @@
+#ifndef INPUT_READER_H
+#define INPUT_READER_H
+
+#include <charconv>
+#include <cstddef>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "outputWriter.h"
+
+// Reads a floating point number from the start of [first, last) just as std::from_chars(first, last, value) does: the same numbers
+// ("3.2", "-0.5", ".5", "6.02e23", "1E-7", "inf", "nan"; no '+' and no leading whitespace), the same correctly rounded value, the same errors.
+// Most numbers in real data have few digits and a small exponent, and those are converted here with a single exactly rounded multiplication
+// or division (Clinger's fast path); everything else goes to std::from_chars, which in libstdc++ uses Eisel and Lemire's algorithm.
+std::from_chars_result parseFloatingPoint(const char* first, const char* last, double& value);
+
+// The value of a number that parseFloatingPoint (or std::from_chars) found in [first, last) but reported as out of range, the way std::strtod reads it:
+// infinity for a number too large for a double ("1e400", "-0.5e400"), and zero for one too small ("1e-400"), either with the number's sign.
+double outOfRangeValue(const char* first, const char* last);
+
+// A fast replacement for "std::cin >> x" when x is an integer.
+// It reads its file descriptor in large raw blocks, skips whitespace and finds the end of each number 16 bytes at a time, and converts the digits with std::from_chars (no locale, no stream synchronization).
+// Extraction follows the rules from lesson 1.5:
+//     + Leading whitespace (spaces, tabs, newlines) is skipped, waiting for more input if needed.
+//     + As many valid characters as possible are extracted: "5b6" gives 5 and leaves "b6" for the next extraction. "+5" and "-3" are accepted.
+//     + If no characters can be extracted ("abc123"), the value is set to 0 and the reader goes into a fail state. Every later extraction fails immediately until clear() is called.
+//     + A number too big for the variable ("3000000000" into an int) is set to the largest (or smallest) value the type can hold, and the reader goes into a fail state.
+// One difference: a negative number extracted into an unsigned type fails, instead of wrapping around the way std::cin does.
+// Do not mix an InputReader and std::cin on the same input: whatever is in the reader's block is no longer available to std::cin.
+class InputReader
+{
+public:
+    static constexpr std::size_t defaultBlockSize{ 1 << 16 };
+
+    // tied works like std::cin.tie(): that writer is flushed before the reader waits for more input, so prompts appear before the program blocks.
+    explicit InputReader(int fileDescriptor, OutputWriter* tied = nullptr, std::size_t blockSize = defaultBlockSize);
+
+    // Reads from text that is already in memory (e.g. a memory-mapped file). The text is used in place, never copied, and must outlive the reader.
+    InputReader(const char* first, const char* last);
+
+    // The reader points into its buffer, so it can not be copied.
+    InputReader(const InputReader&) = delete;
+    InputReader& operator=(const InputReader&) = delete;
+
+    template <typename T>
+    InputReader& operator>>(T& value)
+    {
+        static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char>, "InputReader only extracts integers");
+
+        if constexpr (std::is_signed_v<T>)
+        {
+            long long extracted{};
+            if (extractSigned(extracted, std::numeric_limits<T>::min(), std::numeric_limits<T>::max()))
+                value = static_cast<T>(extracted);
+        }
+        else
+        {
+            unsigned long long extracted{};
+            if (extractUnsigned(extracted, std::numeric_limits<T>::max()))
+                value = static_cast<T>(extracted);
+        }
+
+        return *this;
+    }
+
+    // Extracts an integer of any length without converting it, and returns its text: the optional sign and the digits.
+    // The text points into the reader's buffer and is only valid until the next extraction. If no integer can be extracted, it is empty and the reader goes into a fail state.
+    std::string_view extractIntegerText();
+
+    bool fail() const { return m_fail; }
+    bool eof() const { return m_eof && m_position == m_end; }
+    explicit operator bool() const { return !m_fail; }
+
+    // Leaves the fail state, so that extraction can be attempted again.
+    void clear() { m_fail = false; }
+
+    // Discards everything up to and including the next newline (like std::cin.ignore(max, '\n')).
+    void ignoreLine();
+
+private:
+    // Both return false if nothing was assigned (the reader was already in a fail state).
+    bool extractSigned(long long& value, long long min, long long max);
+    bool extractUnsigned(unsigned long long& value, unsigned long long max);
+
+    // Skips whitespace, refilling as needed. Returns false at end of input.
+    bool skipWhitespace();
+
+    // Makes sure the whole token starting at m_position is in the buffer, and returns its end: the first character after the optional sign and the digits.
+    const char* tokenEnd();
+
+    // Reads the next block. Returns false if there was nothing more to read.
+    bool refill();
+
+    int m_fileDescriptor{};
+    std::vector<char> m_buffer{};
+    const char* m_position{};
+    const char* m_end{};
+    OutputWriter* m_tied{};
+    bool m_fail{ false };
+    bool m_eof{ false };
+};
+
+// The reader for standard input that every program shares, tied to standardOutput().
+InputReader& standardInput();
+
+#endif
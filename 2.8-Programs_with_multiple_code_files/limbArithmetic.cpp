@@ -0,0 +1,301 @@
+#include "limbArithmetic.h"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace limbs
+{
+    namespace
+    {
+        // Negative, zero or positive as x (xCount limbs) is less than, equal to or greater than y (yCount limbs).
+        int compareUneven(const Limb* x, std::size_t xCount, const Limb* y, std::size_t yCount)
+        {
+            for (; xCount > yCount; --xCount)
+            {
+                if (x[xCount - 1] != 0)
+                    return 1;
+            }
+
+            for (; yCount > xCount; --yCount)
+            {
+                if (y[yCount - 1] != 0)
+                    return -1;
+            }
+
+            return compare(x, y, xCount);
+        }
+
+        // out = |x - y|, max(xCount, yCount) limbs. Returns true if x < y.
+        bool absoluteDifference(const Limb* x, std::size_t xCount, const Limb* y, std::size_t yCount, Limb* out)
+        {
+            std::size_t count{ std::max(xCount, yCount) };
+            bool negative{ compareUneven(x, xCount, y, yCount) < 0 };
+            if (negative)
+            {
+                std::swap(x, y);
+                std::swap(xCount, yCount);
+            }
+
+            // x is now the larger. Where it is also the shorter, its extra limbs are all zero, and so are the difference's.
+            std::size_t common{ std::min(xCount, yCount) };
+            unsigned char borrow{ subtract(x, y, out, common, 0) };
+            if (xCount > common)
+                propagateBorrow(x + common, out + common, xCount - common, borrow);
+
+            std::fill(out + xCount, out + count, 0);
+            return negative;
+        }
+    }
+
+    // Four limbs per iteration, so that the carry mostly stays in the flags instead of going through a register for the loop test.
+    unsigned char add(const Limb* x, const Limb* y, Limb* out, std::size_t count, unsigned char carry)
+    {
+        std::size_t i{ 0 };
+        for (; i + 4 <= count; i += 4)
+        {
+            carry = addWithCarry(carry, x[i], y[i], out[i]);
+            carry = addWithCarry(carry, x[i + 1], y[i + 1], out[i + 1]);
+            carry = addWithCarry(carry, x[i + 2], y[i + 2], out[i + 2]);
+            carry = addWithCarry(carry, x[i + 3], y[i + 3], out[i + 3]);
+        }
+
+        for (; i < count; ++i)
+            carry = addWithCarry(carry, x[i], y[i], out[i]);
+
+        return carry;
+    }
+
+    unsigned char subtract(const Limb* x, const Limb* y, Limb* out, std::size_t count, unsigned char borrow)
+    {
+        std::size_t i{ 0 };
+        for (; i + 4 <= count; i += 4)
+        {
+            borrow = subtractWithBorrow(borrow, x[i], y[i], out[i]);
+            borrow = subtractWithBorrow(borrow, x[i + 1], y[i + 1], out[i + 1]);
+            borrow = subtractWithBorrow(borrow, x[i + 2], y[i + 2], out[i + 2]);
+            borrow = subtractWithBorrow(borrow, x[i + 3], y[i + 3], out[i + 3]);
+        }
+
+        for (; i < count; ++i)
+            borrow = subtractWithBorrow(borrow, x[i], y[i], out[i]);
+
+        return borrow;
+    }
+
+    // The carry (or borrow) rarely ripples for long; after it stops, the rest is a copy.
+    unsigned char propagateCarry(const Limb* x, Limb* out, std::size_t count, unsigned char carry)
+    {
+        std::size_t i{ 0 };
+        for (; i < count && carry; ++i)
+        {
+            out[i] = x[i] + 1;
+            carry = out[i] == 0;
+        }
+
+        if (out != x)
+            std::copy(x + i, x + count, out + i);
+
+        return carry;
+    }
+
+    unsigned char propagateBorrow(const Limb* x, Limb* out, std::size_t count, unsigned char borrow)
+    {
+        std::size_t i{ 0 };
+        for (; i < count && borrow; ++i)
+        {
+            borrow = x[i] == 0; // Before writing: out may be x.
+            out[i] = x[i] - 1;
+        }
+
+        if (out != x)
+            std::copy(x + i, x + count, out + i);
+
+        return borrow;
+    }
+
+    unsigned char addInto(Limb* x, std::size_t xCount, const Limb* y, std::size_t count)
+    {
+        unsigned char carry{ add(x, y, x, count, 0) };
+        return propagateCarry(x + count, x + count, xCount - count, carry);
+    }
+
+    int compare(const Limb* x, const Limb* y, std::size_t count)
+    {
+        for (std::size_t i{ count }; i-- > 0;)
+        {
+            if (x[i] != y[i])
+                return x[i] < y[i] ? -1 : 1;
+        }
+
+        return 0;
+    }
+
+    Limb multiplyByLimb(const Limb* x, std::size_t count, Limb factor, Limb* out)
+    {
+        Limb carry{ 0 };
+        for (std::size_t i{ 0 }; i < count; ++i)
+        {
+            Limb high{};
+            Limb low{ multiplyWide(x[i], factor, high) };
+            out[i] = low + carry;
+            carry = high + (out[i] < low);
+        }
+
+        return carry;
+    }
+
+    Limb addMultiplyByLimb(const Limb* x, std::size_t count, Limb factor, Limb* out)
+    {
+        Limb carry{ 0 };
+        for (std::size_t i{ 0 }; i < count; ++i)
+        {
+            Limb high{};
+            Limb low{ multiplyWide(x[i], factor, high) };
+            low += carry;
+            high += low < carry;
+
+            Limb sum{ out[i] + low };
+            high += sum < low;
+            out[i] = sum;
+            carry = high;
+        }
+
+        return carry;
+    }
+
+    void multiplySchoolbook(const Limb* x, std::size_t xCount, const Limb* y, std::size_t yCount, Limb* out)
+    {
+        // The longer operand in the inner loop, so that the loop overhead is paid for the fewest rows.
+        if (xCount < yCount)
+        {
+            std::swap(x, y);
+            std::swap(xCount, yCount);
+        }
+
+        if (yCount == 0)
+        {
+            std::fill(out, out + xCount, 0);
+            return;
+        }
+
+        out[xCount] = multiplyByLimb(x, xCount, y[0], out);
+        for (std::size_t j{ 1 }; j < yCount; ++j)
+            out[xCount + j] = addMultiplyByLimb(x, xCount, y[j], out + j);
+    }
+
+    // Each level needs 4 * high limbs for itself (high = count - count / 2), then the same again for the level below.
+    std::size_t karatsubaScratchSize(std::size_t count)
+    {
+        std::size_t size{ 0 };
+        while (count >= karatsubaThreshold)
+        {
+            std::size_t high{ count - count / 2 };
+            size += 4 * high;
+            count = high;
+        }
+
+        // The last level's 2 * high + 1 limbs for the middle product reuse the space of the level below, which needs at least that much.
+        return size + 2 * count + 1;
+    }
+
+    // With x = x1 * B + x0 and y = y1 * B + y0 (B = 2^(64 * low)):
+    //     x * y = x1 * y1 * B^2 + (x0 * y0 + x1 * y1 + (x0 - x1) * (y1 - y0)) * B + x0 * y0
+    // which is three half-size products instead of four.
+    void multiplyKaratsuba(const Limb* x, const Limb* y, std::size_t count, Limb* out, Limb* scratch)
+    {
+        if (count < karatsubaThreshold)
+        {
+            multiplySchoolbook(x, count, y, count, out);
+            return;
+        }
+
+        std::size_t low{ count / 2 };
+        std::size_t high{ count - low };
+
+        // x0 * y0 and x1 * y1 go straight to their places in out.
+        multiplyKaratsuba(x, y, low, out, scratch);
+        multiplyKaratsuba(x + low, y + low, high, out + 2 * low, scratch);
+
+        Limb* xDifference{ scratch };
+        Limb* yDifference{ scratch + high };
+        Limb* product{ scratch + 2 * high };
+        Limb* deeper{ scratch + 4 * high };
+
+        bool xNegative{ absoluteDifference(x, low, x + low, high, xDifference) };
+        bool yNegative{ absoluteDifference(y + low, high, y, low, yDifference) };
+        multiplyKaratsuba(xDifference, yDifference, high, product, deeper);
+
+        // The middle term is never negative, and fits in 2 * high + 1 limbs. The level below is done with its scratch space.
+        Limb* middle{ deeper };
+        std::copy(out + 2 * low, out + 2 * count, middle);
+        middle[2 * high] = 0;
+        addInto(middle, 2 * high + 1, out, 2 * low);
+
+        if (xNegative == yNegative)
+            addInto(middle, 2 * high + 1, product, 2 * high);
+        else
+            middle[2 * high] -= subtract(middle, product, middle, 2 * high, 0);
+
+        addInto(out + low, 2 * count - low, middle, 2 * high + 1);
+    }
+
+    void divideExact(const Limb* x, std::size_t count, Limb divisor, Limb* out)
+    {
+        // The inverse of divisor modulo 2^64. Each Newton step doubles the number of correct low bits, starting from 3.
+        Limb inverse{ divisor };
+        for (int i{ 0 }; i < 5; ++i)
+            inverse *= 2 - divisor * inverse;
+
+        Limb borrow{ 0 };
+        for (std::size_t i{ 0 }; i < count; ++i)
+        {
+            Limb value{ x[i] };
+            Limb reduced{ value - borrow };
+            Limb nextBorrow{ value < borrow };
+
+            Limb quotient{ reduced * inverse };
+            out[i] = quotient;
+
+            Limb high{};
+            multiplyWide(quotient, divisor, high);
+            borrow = high + nextBorrow;
+        }
+    }
+
+    void shiftRight(const Limb* x, std::size_t count, unsigned bits, Limb* out)
+    {
+        if (count == 0)
+            return;
+
+        if (bits == 0)
+        {
+            std::copy(x, x + count, out);
+            return;
+        }
+
+        for (std::size_t i{ 0 }; i + 1 < count; ++i)
+            out[i] = (x[i] >> bits) | (x[i + 1] << (64 - bits));
+
+        out[count - 1] = x[count - 1] >> bits;
+    }
+
+    Limb shiftLeft(const Limb* x, std::size_t count, unsigned bits, Limb* out)
+    {
+        if (bits == 0)
+        {
+            std::copy(x, x + count, out);
+            return 0;
+        }
+
+        if (count == 0)
+            return 0;
+
+        // From the top down, so that out may be x.
+        Limb shiftedOut{ x[count - 1] >> (64 - bits) };
+        for (std::size_t i{ count - 1 }; i > 0; --i)
+            out[i] = (x[i] << bits) | (x[i - 1] >> (64 - bits));
+
+        out[0] = x[0] << bits;
+        return shiftedOut;
+    }
+}
@@ -0,0 +1,112 @@
+#ifndef LIMB_ARITHMETIC_H
+#define LIMB_ARITHMETIC_H
+
+#include <cstddef>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define LIMB_ARITHMETIC_HAS_ADC
+#include <immintrin.h>
+#endif
+
+// The loops under BigInteger: arithmetic on unsigned numbers stored as arrays of 64-bit limbs, least significant first.
+// Nothing here allocates; callers pass output arrays (and scratch space) of the documented sizes.
+namespace limbs
+{
+    // unsigned long long rather than std::uint64_t (which can be unsigned long): the add-with-carry intrinsics write through an unsigned long long*.
+    using Limb = unsigned long long;
+    static_assert(sizeof(Limb) * 8 == 64, "A limb holds 64 bits");
+
+    // Below this many limbs Karatsuba's extra additions cost more than the multiplications it saves, and schoolbook is used.
+    // Both crossovers were measured with "benchmark.out multiply"; they are broad minimums, so nearby values do about as well.
+    constexpr std::size_t karatsubaThreshold{ 24 };
+
+    // From this many limbs on, BigInteger multiplies with Toom-3 (five products of a third of the size) instead of Karatsuba (three of half the size).
+    constexpr std::size_t toom3Threshold{ 160 };
+
+    inline unsigned char addWithCarry(unsigned char carry, Limb x, Limb y, Limb& sum)
+    {
+#ifdef LIMB_ARITHMETIC_HAS_ADC
+        return _addcarry_u64(carry, x, y, &sum);
+#else
+        Limb partial{ x + y };
+        Limb total{ partial + carry };
+        sum = total;
+        return static_cast<unsigned char>((partial < x) | (total < partial));
+#endif
+    }
+
+    inline unsigned char subtractWithBorrow(unsigned char borrow, Limb x, Limb y, Limb& difference)
+    {
+#ifdef LIMB_ARITHMETIC_HAS_ADC
+        return _subborrow_u64(borrow, x, y, &difference);
+#else
+        Limb partial{ x - y };
+        Limb total{ partial - borrow };
+        difference = total;
+        return static_cast<unsigned char>((x < y) | (partial < borrow));
+#endif
+    }
+
+    // The low 64 bits of x * y, with the high 64 bits in high.
+    inline Limb multiplyWide(Limb x, Limb y, Limb& high)
+    {
+#ifdef __SIZEOF_INT128__
+        unsigned __int128 product{ static_cast<unsigned __int128>(x) * y };
+        high = static_cast<Limb>(product >> 64);
+        return static_cast<Limb>(product);
+#else
+        Limb xLow{ x & 0xFFFFFFFF };
+        Limb xHigh{ x >> 32 };
+        Limb yLow{ y & 0xFFFFFFFF };
+        Limb yHigh{ y >> 32 };
+
+        Limb low{ xLow * yLow };
+        Limb middle1{ xHigh * yLow + (low >> 32) };
+        Limb middle2{ xLow * yHigh + (middle1 & 0xFFFFFFFF) };
+
+        high = xHigh * yHigh + (middle1 >> 32) + (middle2 >> 32);
+        return (middle2 << 32) | (low & 0xFFFFFFFF);
+#endif
+    }
+
+    // out = x + y over count limbs, starting with carry. Returns the carry out of the top limb. out may be x or y.
+    unsigned char add(const Limb* x, const Limb* y, Limb* out, std::size_t count, unsigned char carry);
+
+    // out = x - y over count limbs, starting with borrow. Returns the borrow out of the top limb. out may be x or y.
+    unsigned char subtract(const Limb* x, const Limb* y, Limb* out, std::size_t count, unsigned char borrow);
+
+    // out = x + carry (or x - borrow) over count limbs, for the part of the longer operand that the shorter one does not reach.
+    unsigned char propagateCarry(const Limb* x, Limb* out, std::size_t count, unsigned char carry);
+    unsigned char propagateBorrow(const Limb* x, Limb* out, std::size_t count, unsigned char borrow);
+
+    // Adds y (count limbs) into x (xCount limbs, at least count) in place. Returns the carry out of x's top limb.
+    unsigned char addInto(Limb* x, std::size_t xCount, const Limb* y, std::size_t count);
+
+    // Negative, zero or positive as x is less than, equal to or greater than y, both count limbs long.
+    int compare(const Limb* x, const Limb* y, std::size_t count);
+
+    // out = x * factor over count limbs. Returns the limb that goes above them. out may be x.
+    Limb multiplyByLimb(const Limb* x, std::size_t count, Limb factor, Limb* out);
+
+    // out += x * factor over count limbs. Returns the limb that goes above them.
+    Limb addMultiplyByLimb(const Limb* x, std::size_t count, Limb factor, Limb* out);
+
+    // out = x * y, xCount + yCount limbs. out must not overlap x or y.
+    void multiplySchoolbook(const Limb* x, std::size_t xCount, const Limb* y, std::size_t yCount, Limb* out);
+
+    // out = x * y for two numbers of count limbs each, 2 * count limbs. out must not overlap x or y.
+    // scratch needs karatsubaScratchSize(count) limbs.
+    void multiplyKaratsuba(const Limb* x, const Limb* y, std::size_t count, Limb* out, Limb* scratch);
+    std::size_t karatsubaScratchSize(std::size_t count);
+
+    // out = x / divisor for an odd divisor that is known to divide x exactly, which is a multiplication instead of a division per limb. out may be x.
+    void divideExact(const Limb* x, std::size_t count, Limb divisor, Limb* out);
+
+    // out = x >> bits, for bits below 64. out may be x.
+    void shiftRight(const Limb* x, std::size_t count, unsigned bits, Limb* out);
+
+    // out = x << bits, for bits below 64, over count limbs. Returns the bits shifted out of the top limb. out may be x.
+    Limb shiftLeft(const Limb* x, std::size_t count, unsigned bits, Limb* out);
+}
+
+#endif
@@ -65,17 +65,99 @@ SUMMARY
 + Reminder: Whenever you create a new code file (.cpp), you will need to add it to your project so that it gets compiled.
 */
 
-#include <string>
+#include <cstdio>
+#include <cstring>
 #include <iostream>
 
-int add(int x, int y);
-int getInputWithNote(std::string content);
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
 
-int main()
+#include "add.h"
+#include "addBatch.h"
+#include "bigInteger.h"
+#include "getInputWithNote.h"
+#include "inputReader.h"
+#include "mappedInput.h"
+#include "outputWriter.h"
+
+// Prompts only make sense when a person is typing. When stdin is a file or a pipe (e.g. generated workloads), we add pairs in batch instead.
+bool isInteractiveInput()
+{
+#if defined(_WIN32)
+    return _isatty(_fileno(stdin)) != 0;
+#else
+    return isatty(STDIN_FILENO) != 0;
+#endif
+}
+
+// One output line of the file mode: the sum of the pair.
+void writeSum(int first, int second, OutputWriter& out)
 {
+    out << add(first, second) << '\n';
+}
+
+// The interactive adder for numbers of any size.
+int addBigInteractive()
+{
+    BigInteger first{};
+    BigInteger second{};
+
+    standardOutput() << "Enter first number: ";
+    standardInput() >> first;
+    standardOutput() << "Enter second number: ";
+    standardInput() >> second;
+
+    standardOutput() << "The sum of " << first << " and " << second << " is: " << add(first, second) << "\n";
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    bool batch{ !isInteractiveInput() };
+    bool big{ false };
+    const char* path{ nullptr };
+
+    for (int i{ 1 }; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--batch") == 0)
+            batch = true;
+        else if (std::strcmp(argv[i], "--interactive") == 0)
+            batch = false;
+        else if (std::strcmp(argv[i], "--big") == 0)
+            big = true;
+        else if (std::strcmp(argv[i], "--file") == 0 && i + 1 < argc)
+            path = argv[++i];
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [--big] [--batch | --interactive | --file <path>]\n";
+            return 2;
+        }
+    }
+
+    if (path && big)
+    {
+        std::cerr << "--big does not work with --file: the file mode reads int pairs.\n";
+        return 2;
+    }
+
+    if (path)
+        return processPairFile(path, writeSum, standardOutput()) ? 0 : 1;
+
+    if (big && batch)
+        return runBigAddBatch(standardInput(), standardOutput()) ? 0 : 1;
+
+    if (big)
+        return addBigInteractive();
+
+    if (batch)
+        return runAddBatch(standardInput(), standardOutput()) ? 0 : 1;
+
     int first{getInputWithNote("Enter first number: ")};
     int second{getInputWithNote("Enter second number: ")};
 
-    std::cout << "The sum of " << first << " and " << second << " is: " << add(first, second) << "\n";
+    standardOutput() << "The sum of " << first << " and " << second << " is: " << add(first, second) << "\n";
     return 0;
 }
\ No newline at end of file
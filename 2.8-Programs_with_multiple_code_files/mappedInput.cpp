@@ -0,0 +1,206 @@
+#include "mappedInput.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "inputReader.h"
+#include "outputWriter.h"
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const char* path)
+{
+#if defined(_WIN32)
+    HANDLE file{ CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr) };
+    if (file == INVALID_HANDLE_VALUE)
+        return;
+
+    m_file = file;
+
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file, &size))
+        return;
+
+    m_size = static_cast<std::size_t>(size.QuadPart);
+    if (m_size == 0)
+    {
+        m_open = true;
+        return;
+    }
+
+    m_mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!m_mapping)
+        return;
+
+    m_data = static_cast<const char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+    m_open = m_data != nullptr;
+#else
+    int file{ open(path, O_RDONLY) };
+    if (file < 0)
+        return;
+
+    struct stat info{};
+    if (fstat(file, &info) == 0)
+    {
+        m_size = static_cast<std::size_t>(info.st_size);
+        m_open = true;
+
+        if (m_size > 0)
+        {
+            void* mapping{ mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, file, 0) };
+            if (mapping == MAP_FAILED)
+            {
+                m_open = false;
+                m_size = 0;
+            }
+            else
+            {
+                // We read front to back, so the kernel can read ahead aggressively.
+                madvise(mapping, m_size, MADV_SEQUENTIAL);
+                m_data = static_cast<const char*>(mapping);
+            }
+        }
+    }
+
+    // The mapping keeps the file contents available after the descriptor is closed.
+    close(file);
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+#if defined(_WIN32)
+    if (m_data)
+        UnmapViewOfFile(m_data);
+    if (m_mapping)
+        CloseHandle(m_mapping);
+    if (m_file)
+        CloseHandle(m_file);
+#else
+    if (m_data)
+        munmap(const_cast<char*>(m_data), m_size);
+#endif
+}
+
+std::vector<TextChunk> splitAtLines(const char* first, const char* last, std::size_t chunkSize)
+{
+    std::vector<TextChunk> chunks{};
+
+    while (first != last)
+    {
+        if (static_cast<std::size_t>(last - first) <= chunkSize)
+        {
+            chunks.push_back({ first, last });
+            break;
+        }
+
+        const char* target{ first + chunkSize };
+        const char* newline{ static_cast<const char*>(std::memchr(target, '\n', static_cast<std::size_t>(last - target))) };
+        const char* end{ newline ? newline + 1 : last };
+
+        chunks.push_back({ first, end });
+        first = end;
+    }
+
+    return chunks;
+}
+
+namespace
+{
+    // Big enough that starting a chunk costs nothing in comparison, small enough that a round of chunks (one per core) keeps little output in memory.
+    constexpr std::size_t chunkSize{ 8 << 20 };
+
+    struct ChunkResult
+    {
+        OutputWriter output{}; // In memory, until it is this chunk's turn to be written.
+        long long pairs{ 0 };
+        bool valid{ true };
+    };
+
+    void processChunk(const TextChunk& chunk, PairFunction function, ChunkResult& result)
+    {
+        InputReader in{ chunk.first, chunk.last };
+
+        result.output.clear();
+        result.pairs = 0;
+        result.valid = true;
+
+        int first{};
+        int second{};
+
+        while (in >> first)
+        {
+            if (!(in >> second))
+            {
+                result.valid = false;
+                return;
+            }
+
+            function(first, second, result.output);
+            ++result.pairs;
+        }
+
+        result.valid = in.eof();
+    }
+}
+
+bool processPairFile(const char* path, PairFunction function, OutputWriter& out, unsigned threads)
+{
+    MappedFile file{ path };
+    if (!file.isOpen())
+    {
+        std::cerr << "Can not open " << path << ".\n";
+        return false;
+    }
+
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<TextChunk> chunks{ splitAtLines(file.data(), file.data() + file.size(), chunkSize) };
+    std::vector<ChunkResult> results(threads);
+    long long pairs{ 0 };
+
+    // Each round hands one chunk to every core. The main thread works on a chunk too, then writes the round's output in input order.
+    for (std::size_t round{ 0 }; round < chunks.size(); round += threads)
+    {
+        std::size_t inRound{ std::min<std::size_t>(threads, chunks.size() - round) };
+
+        std::vector<std::thread> workers{};
+        for (std::size_t i{ 1 }; i < inRound; ++i)
+            workers.emplace_back(processChunk, std::cref(chunks[round + i]), function, std::ref(results[i]));
+
+        processChunk(chunks[round], function, results[0]);
+
+        for (std::thread& worker : workers)
+            worker.join();
+
+        for (std::size_t i{ 0 }; i < inRound; ++i)
+        {
+            out.write(results[i].output.text());
+            pairs += results[i].pairs;
+
+            if (!results[i].valid)
+            {
+                out.flush();
+                std::cerr << "File stopped after " << pairs << " pairs: expected two integers per pair.\n";
+                return false;
+            }
+        }
+    }
+
+    out.flush();
+    return true;
+}
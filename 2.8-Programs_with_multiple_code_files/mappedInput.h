@@ -0,0 +1,50 @@
+#ifndef MAPPED_INPUT_H
+#define MAPPED_INPUT_H
+
+#include <cstddef>
+#include <vector>
+
+#include "outputWriter.h"
+
+// A read-only memory mapping of a whole file. The operating system pages the file in as it is read, so even a multi-GB file is never copied into our own buffers.
+class MappedFile
+{
+public:
+    explicit MappedFile(const char* path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool isOpen() const { return m_open; }
+    const char* data() const { return m_data; }
+    std::size_t size() const { return m_size; }
+
+private:
+    const char* m_data{}; // Stays null for an empty file, which opens fine but has nothing to map.
+    std::size_t m_size{ 0 };
+    bool m_open{ false };
+#if defined(_WIN32)
+    void* m_file{};
+    void* m_mapping{};
+#endif
+};
+
+struct TextChunk
+{
+    const char* first{};
+    const char* last{};
+};
+
+// Splits [first, last) into about chunkSize-character pieces. Every piece but the last ends just after a newline, so no line is ever cut in two.
+std::vector<TextChunk> splitAtLines(const char* first, const char* last, std::size_t chunkSize);
+
+// Called once per "a b" pair. Writes the output for that pair (including its newline) to out.
+using PairFunction = void (*)(int first, int second, OutputWriter& out);
+
+// File mode for the two-number programs: memory-maps the file at path, which holds whitespace-separated integer pairs with each pair on a single line.
+// The file is cut into chunks at line boundaries, the chunks are parsed and computed on all cores, and their output is written to out in input order. out is flushed when done.
+// Returns false (after reporting on stderr) if the file can not be opened, contains something that is not an integer, or ends in the middle of a pair.
+bool processPairFile(const char* path, PairFunction function, OutputWriter& out, unsigned threads = 0);
+
+#endif
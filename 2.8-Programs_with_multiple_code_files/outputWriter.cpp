@@ -0,0 +1,258 @@
+#include "outputWriter.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string_view>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    // "00", "01", ..., "99": two digits per lookup halves the number of divisions.
+    struct DigitPairs
+    {
+        char digits[200]{};
+
+        constexpr DigitPairs()
+        {
+            for (int i{ 0 }; i < 100; ++i)
+            {
+                digits[i * 2] = static_cast<char>('0' + i / 10);
+                digits[i * 2 + 1] = static_cast<char>('0' + i % 10);
+            }
+        }
+    };
+
+    constexpr DigitPairs digitPairs{};
+
+    int countDigits(std::uint32_t value)
+    {
+        if (value < 100000)
+            return value < 100 ? (value < 10 ? 1 : 2) : (value < 1000 ? 3 : (value < 10000 ? 4 : 5));
+
+        return value < 10000000 ? (value < 1000000 ? 6 : 7) : (value < 100000000 ? 8 : (value < 1000000000 ? 9 : 10));
+    }
+
+    // Fills the digits backwards from end, two at a time. Most numbers fit in 32 bits, where dividing by 100 is a cheap multiply.
+    void formatDigitsBackwards(char* end, std::uint32_t value)
+    {
+        while (value >= 100)
+        {
+            std::uint32_t pair{ value % 100 };
+            value /= 100;
+            end -= 2;
+            std::memcpy(end, digitPairs.digits + pair * 2, 2);
+        }
+
+        if (value >= 10)
+            std::memcpy(end - 2, digitPairs.digits + value * 2, 2);
+        else
+            end[-1] = static_cast<char>('0' + value);
+    }
+}
+
+char* formatInteger(char* out, unsigned long long value)
+{
+    if (value <= 0xFFFFFFFFull)
+    {
+        std::uint32_t small{ static_cast<std::uint32_t>(value) };
+        char* end{ out + countDigits(small) };
+        formatDigitsBackwards(end, small);
+        return end;
+    }
+
+    // Split off the low 9 digits (always written in full, with leading zeros), then format what is left the same way.
+    std::uint32_t low{ static_cast<std::uint32_t>(value % 1000000000) };
+    char* end{ formatInteger(out, value / 1000000000) + 9 };
+
+    char* position{ end };
+    for (int pairs{ 0 }; pairs < 4; ++pairs)
+    {
+        position -= 2;
+        std::memcpy(position, digitPairs.digits + (low % 100) * 2, 2);
+        low /= 100;
+    }
+    position[-1] = static_cast<char>('0' + low);
+
+    return end;
+}
+
+char* formatInteger(char* out, long long value)
+{
+    // Negating as unsigned also works for the smallest long long, which has no positive counterpart.
+    unsigned long long magnitude{ static_cast<unsigned long long>(value) };
+    if (value < 0)
+    {
+        *out++ = '-';
+        magnitude = 0ull - magnitude;
+    }
+
+    return formatInteger(out, magnitude);
+}
+
+namespace
+{
+    template <typename T>
+    char* formatFloatingPointValue(char* out, T value, FloatFormat format)
+    {
+        // Below 2^53 (2^24 for a float) every whole number is exact, and its shortest digits in fixed notation are simply all of them:
+        // the integer formatting above writes those several times faster than the general algorithm. Measurements and counts often are whole.
+        constexpr T exactIntegers{ static_cast<T>(std::uint64_t{ 1 } << std::numeric_limits<T>::digits) };
+        if (format != FloatFormat::scientific && std::fabs(value) < exactIntegers && static_cast<T>(static_cast<std::int64_t>(value)) == value)
+        {
+            char* first{ out };
+            if (std::signbit(value))
+                *out++ = '-'; // -0.0 too.
+
+            char* end{ formatInteger(out, static_cast<unsigned long long>(std::fabs(value))) };
+            if (format == FloatFormat::fixed)
+                return end;
+
+            // Scientific notation wins when it is shorter: "1e+06" for 1000000, or "1.5e+07". Its exponent has two digits here.
+            std::size_t length{ static_cast<std::size_t>(end - out) };
+            std::size_t significant{ length };
+            while (significant > 1 && out[significant - 1] == '0')
+                --significant;
+
+            if (length <= significant + (significant > 1 ? 1 : 0) + 4)
+                return end;
+
+            out = first;
+        }
+
+        // std::to_chars finds the shortest digits with Ryu (in libstdc++, and Microsoft's library), in a few dozen nanoseconds.
+        char* last{ out + maxFloatingPointLength };
+        switch (format)
+        {
+        case FloatFormat::fixed:
+            return std::to_chars(out, last, value, std::chars_format::fixed).ptr;
+        case FloatFormat::scientific:
+            return std::to_chars(out, last, value, std::chars_format::scientific).ptr;
+        case FloatFormat::shortest:
+            break;
+        }
+
+        return std::to_chars(out, last, value).ptr;
+    }
+}
+
+char* formatFloatingPoint(char* out, double value, FloatFormat format)
+{
+    return formatFloatingPointValue(out, value, format);
+}
+
+char* formatFloatingPoint(char* out, float value, FloatFormat format)
+{
+    return formatFloatingPointValue(out, value, format);
+}
+
+OutputWriter::OutputWriter()
+    : m_buffer(1 << 12)
+{
+}
+
+OutputWriter::OutputWriter(int fileDescriptor, FlushPolicy policy, std::size_t bufferSize)
+    : m_fileDescriptor{ fileDescriptor }, m_policy{ policy }, m_buffer(bufferSize)
+{
+}
+
+OutputWriter::~OutputWriter()
+{
+    flush();
+}
+
+void OutputWriter::writeToDescriptor(const char* first, std::size_t size)
+{
+    while (size > 0)
+    {
+#if defined(_WIN32)
+        long long written{ _write(m_fileDescriptor, first, static_cast<unsigned>(size)) };
+#else
+        long long written{ static_cast<long long>(::write(m_fileDescriptor, first, size)) };
+#endif
+        if (written <= 0)
+            return; // Nowhere to report it: the output is gone (e.g. the pipe was closed).
+
+        first += written;
+        size -= static_cast<std::size_t>(written);
+    }
+}
+
+void OutputWriter::flush()
+{
+    if (m_fileDescriptor < 0 || m_length == 0)
+        return;
+
+    writeToDescriptor(m_buffer.data(), m_length);
+    m_length = 0;
+}
+
+void OutputWriter::makeRoom(std::size_t size)
+{
+    if (m_fileDescriptor < 0)
+    {
+        m_buffer.resize(std::max(m_buffer.size() * 2, m_length + size));
+        return;
+    }
+
+    flush();
+    if (m_buffer.size() < size)
+        m_buffer.resize(size);
+}
+
+OutputWriter& OutputWriter::write(std::string_view text)
+{
+    bool lineEnded{ m_policy == FlushPolicy::everyLine && text.find('\n') != std::string_view::npos };
+
+    if (m_fileDescriptor >= 0 && text.size() > m_buffer.size() - m_length)
+    {
+        // Too big for the space left: send the buffer and the text in one call, without copying the text.
+#if defined(_WIN32)
+        flush();
+        writeToDescriptor(text.data(), text.size());
+#else
+        iovec parts[2]{ { m_buffer.data(), m_length }, { const_cast<char*>(text.data()), text.size() } };
+        std::size_t total{ m_length + text.size() };
+        long long written{ static_cast<long long>(writev(m_fileDescriptor, parts, 2)) };
+        if (written < 0)
+            written = 0;
+
+        // A partial write (e.g. to a full pipe) is finished piece by piece.
+        std::size_t done{ static_cast<std::size_t>(written) };
+        if (done < m_length)
+        {
+            writeToDescriptor(m_buffer.data() + done, m_length - done);
+            done = m_length;
+        }
+        if (done < total)
+            writeToDescriptor(text.data() + (done - m_length), total - done);
+#endif
+        m_length = 0;
+        return *this;
+    }
+
+    reserve(text.size());
+    std::memcpy(m_buffer.data() + m_length, text.data(), text.size());
+    m_length += text.size();
+
+    if (lineEnded)
+        flush();
+
+    return *this;
+}
+
+OutputWriter& standardOutput()
+{
+    static OutputWriter writer{ 1 };
+    return writer;
+}
@@ -0,0 +1,156 @@
+#ifndef OUTPUT_WRITER_H
+#define OUTPUT_WRITER_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+// Writes the decimal digits of value to out, which needs room for 20 characters (21 for a negative value). Returns the end of the digits.
+char* formatInteger(char* out, unsigned long long value);
+char* formatInteger(char* out, long long value);
+
+// How formatFloatingPoint() writes a number. Each gives the fewest significant digits that read back (std::from_chars, strtod,
+// std::cin >>) as exactly the same value, so that nothing is lost, unlike std::setprecision(6) (lesson 4.8); and no more, unlike setprecision(17).
+enum class FloatFormat
+{
+    shortest,   // Fixed or scientific, whichever is shorter, fixed on a tie: "0.1", "1234.5", "1e+22", "1e-07".
+    fixed,      // Never an exponent: "10000000000000000000000", "0.0000001".
+    scientific, // One digit before the point and an exponent, as in lesson 4.7: "1.2345e+03", "1e-07".
+};
+
+// The longest text formatFloatingPoint() writes: a double just above the smallest normal one in fixed notation,
+// "-0.00...00020182982189170015", with 307 zeros after the point.
+constexpr std::size_t maxFloatingPointLength{ 327 };
+
+// Writes value to out, which needs room for maxFloatingPointLength characters, without locale or stream state. Returns the end of the text.
+// Infinity and NaN are written "inf" and "nan" (with a '-' for a negative one), which std::from_chars reads back.
+char* formatFloatingPoint(char* out, double value, FloatFormat format = FloatFormat::shortest);
+char* formatFloatingPoint(char* out, float value, FloatFormat format = FloatFormat::shortest);
+
+// When an OutputWriter hands its buffer to the operating system.
+// Lesson 1.5 explains why std::endl is slow: it flushes on every line. Flushing is expensive, so the default is to only flush when the buffer is full (or on flush(), or when the writer is destroyed at exit).
+enum class FlushPolicy
+{
+    whenFull,
+    everyLine, // Like a terminal would want it: every '\n' written also flushes.
+};
+
+// A fast replacement for "std::cout << x" for text, integers and floating point numbers.
+// Everything goes into one large buffer. Integers are formatted two digits at a time from a lookup table, without locale or stream state;
+// floating point numbers with their shortest exact digits (see formatFloatingPoint()).
+// Text too big for the space left is not copied: it goes out together with the buffer in a single gathered write (writev).
+// A writer built without a file descriptor keeps everything in memory instead, growing as needed (see text()).
+class OutputWriter
+{
+public:
+    static constexpr std::size_t defaultBufferSize{ 1 << 20 };
+
+    OutputWriter();
+    explicit OutputWriter(int fileDescriptor, FlushPolicy policy = FlushPolicy::whenFull, std::size_t bufferSize = defaultBufferSize);
+    ~OutputWriter();
+
+    OutputWriter(const OutputWriter&) = delete;
+    OutputWriter& operator=(const OutputWriter&) = delete;
+
+    OutputWriter& write(std::string_view text);
+
+    // The single-character and integer writes are called once per value, so their common case (enough room left) is kept inline.
+    OutputWriter& write(char c)
+    {
+        reserve(1);
+        m_buffer[m_length++] = c;
+
+        if (c == '\n' && m_policy == FlushPolicy::everyLine)
+            flush();
+
+        return *this;
+    }
+
+    OutputWriter& writeInteger(long long value)
+    {
+        reserve(maxIntegerLength);
+        m_length = static_cast<std::size_t>(formatInteger(m_buffer.data() + m_length, value) - m_buffer.data());
+        return *this;
+    }
+
+    OutputWriter& writeInteger(unsigned long long value)
+    {
+        reserve(maxIntegerLength);
+        m_length = static_cast<std::size_t>(formatInteger(m_buffer.data() + m_length, value) - m_buffer.data());
+        return *this;
+    }
+
+    OutputWriter& writeFloatingPoint(double value, FloatFormat format = FloatFormat::shortest)
+    {
+        reserve(maxFloatingPointLength);
+        m_length = static_cast<std::size_t>(formatFloatingPoint(m_buffer.data() + m_length, value, format) - m_buffer.data());
+        return *this;
+    }
+
+    OutputWriter& writeFloatingPoint(float value, FloatFormat format = FloatFormat::shortest)
+    {
+        reserve(maxFloatingPointLength);
+        m_length = static_cast<std::size_t>(formatFloatingPoint(m_buffer.data() + m_length, value, format) - m_buffer.data());
+        return *this;
+    }
+
+    OutputWriter& operator<<(std::string_view text) { return write(text); }
+    OutputWriter& operator<<(const char* text) { return write(std::string_view{ text }); }
+    OutputWriter& operator<<(const std::string& text) { return write(std::string_view{ text }); }
+    OutputWriter& operator<<(char c) { return write(c); }
+
+    OutputWriter& operator<<(double value) { return writeFloatingPoint(value); }
+    OutputWriter& operator<<(float value) { return writeFloatingPoint(value); }
+
+    template <typename T, typename = std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char>>>
+    OutputWriter& operator<<(T value)
+    {
+        if constexpr (std::is_signed_v<T>)
+            return writeInteger(static_cast<long long>(value));
+        else
+            return writeInteger(static_cast<unsigned long long>(value));
+    }
+
+    // For text formatted straight into the buffer: room for at least size characters, of which commitWrite(count) keeps the first count.
+    // Nothing else may be written in between.
+    char* prepareWrite(std::size_t size)
+    {
+        reserve(size);
+        return m_buffer.data() + m_length;
+    }
+
+    void commitWrite(std::size_t count) { m_length += count; }
+
+    // Hands everything buffered so far to the operating system. Does nothing for an in-memory writer.
+    void flush();
+
+    // For an in-memory writer: everything written so far, and a way to start over.
+    std::string_view text() const { return { m_buffer.data(), m_length }; }
+    void clear() { m_length = 0; }
+
+private:
+    // "-9223372036854775808"
+    static constexpr std::size_t maxIntegerLength{ 21 };
+
+    // Makes room for at least size more characters, flushing (or growing, in memory) as needed.
+    void reserve(std::size_t size)
+    {
+        if (m_buffer.size() - m_length < size)
+            makeRoom(size);
+    }
+
+    void makeRoom(std::size_t size);
+    void writeToDescriptor(const char* first, std::size_t size);
+
+    int m_fileDescriptor{ -1 };
+    FlushPolicy m_policy{ FlushPolicy::whenFull };
+    std::vector<char> m_buffer{};
+    std::size_t m_length{ 0 };
+};
+
+// The writer for standard output that every program shares. It is flushed at exit, and whenever standardInput() waits for input.
+OutputWriter& standardOutput();
+
+#endif
@@ -0,0 +1,60 @@
+#include "scale.h"
+
+#include <cstddef>
+#include <cstdint>
+
+// Compiled once per instruction set; the dynamic loader picks the best one for this CPU.
+#if defined(__GNUC__) && defined(__x86_64__) && defined(__ELF__)
+#define SCALE_KERNEL __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define SCALE_KERNEL
+#endif
+
+namespace arithmetic
+{
+    namespace
+    {
+        using ScaleFunction = void (*)(const std::int32_t*, std::int32_t*, std::size_t);
+
+        // The loop is written out here rather than calling the template in scale.h, so that every clone has its own copy of it.
+        template <std::int32_t Factor>
+        SCALE_KERNEL
+        void scaleKernel(const std::int32_t* in, std::int32_t* out, std::size_t count)
+        {
+            for (std::size_t i{ 0 }; i < count; ++i)
+                out[i] = Wrap::mul(in[i], Factor);
+        }
+
+        // Indexed by factor + 1.
+        const ScaleFunction smallFactorKernels[]{
+            scaleKernel<-1>, scaleKernel<0>, scaleKernel<1>, scaleKernel<2>, scaleKernel<3>, scaleKernel<4>,
+            scaleKernel<5>, scaleKernel<6>, scaleKernel<7>, scaleKernel<8>, scaleKernel<9>, scaleKernel<10>,
+            scaleKernel<11>, scaleKernel<12>, scaleKernel<13>, scaleKernel<14>, scaleKernel<15>, scaleKernel<16>,
+        };
+
+        ScaleFunction scaleKernelFor(std::int32_t factor)
+        {
+            return factor >= -1 && factor <= 16 ? smallFactorKernels[factor + 1] : nullptr;
+        }
+    }
+
+    SCALE_KERNEL
+    void scaleGeneric(const std::int32_t* in, std::int32_t* out, std::size_t count, std::int32_t factor)
+    {
+        for (std::size_t i{ 0 }; i < count; ++i)
+            out[i] = Wrap::mul(in[i], factor);
+    }
+
+    void scale(const std::int32_t* in, std::int32_t* out, std::size_t count, std::int32_t factor)
+    {
+        if (ScaleFunction kernel{ scaleKernelFor(factor) })
+            kernel(in, out, count);
+        else
+            scaleGeneric(in, out, count, factor);
+    }
+
+    bool hasScaleKernel(std::int32_t factor)
+    {
+        return scaleKernelFor(factor) != nullptr;
+    }
+}
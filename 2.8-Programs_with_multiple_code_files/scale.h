@@ -0,0 +1,79 @@
+#ifndef SCALE_H
+#define SCALE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "bigInteger.h"
+#include "fixedWidthArithmetic.h"
+
+// Multiplying by a factor that is known while compiling, as lesson 2.4's doubleNumber() (scale<2>) and lesson 1.11's triple (scale<3>) do.
+// For a constant factor the compiler writes shifts, adds and LEAs instead of a multiply: x * 3 is one LEA, x * 10 a shift-and-add and a shift.
+// The array form gets the same as SIMD shifts and adds, where a factor that is only known at run time needs the vector multiply (vpmulld),
+// which takes twice the micro-operations and ten times the latency. The run time scale() below therefore looks its factor up in a table
+// of kernels compiled for the common constants, and only multiplies for the others.
+// Like arithmetic::Wrap, the fixed-width forms wrap around on overflow.
+namespace arithmetic
+{
+    namespace detail
+    {
+        // Whether value is one of T's values (std::in_range, before C++20).
+        template <typename T, typename V>
+        constexpr bool fitsIn(V value)
+        {
+            if constexpr (std::is_signed_v<V>)
+            {
+                if (value < 0)
+                    return std::is_signed_v<T> && static_cast<long long>(value) >= static_cast<long long>(std::numeric_limits<T>::min());
+            }
+
+            return static_cast<unsigned long long>(value) <= static_cast<unsigned long long>(std::numeric_limits<T>::max());
+        }
+    }
+
+    template <auto Factor, typename T>
+    constexpr T scale(T x)
+    {
+        static_assert(isFixedWidthInteger<T>, "arithmetic::scale only works on the std::intN_t / std::uintN_t types (and BigInteger)");
+        static_assert(detail::fitsIn<T>(Factor), "The factor does not fit in the type it scales, and would be cut down to a different one");
+        return Wrap::mul(x, static_cast<T>(Factor));
+    }
+
+    // Never overflows. A power of two is a shift, anything else one pass with a single-limb multiply.
+    template <auto Factor>
+    BigInteger scale(const BigInteger& x)
+    {
+        if constexpr (Factor > 0 && (Factor & (Factor - 1)) == 0)
+        {
+            std::size_t shift{ 0 };
+            while ((static_cast<unsigned long long>(Factor) >> shift) != 1)
+                ++shift;
+
+            return x << shift;
+        }
+        else
+            return x * BigInteger{ static_cast<long long>(Factor) };
+    }
+
+    // out[i] = scale<Factor>(in[i]) for i in [0, count). out may be the same array as in.
+    template <auto Factor, typename T>
+    void scale(const T* in, T* out, std::size_t count)
+    {
+        for (std::size_t i{ 0 }; i < count; ++i)
+            out[i] = scale<Factor>(in[i]);
+    }
+
+    // out[i] = in[i] * factor, wrapping. Factors from -1 to 16 have a kernel of their own; the rest go to scaleGeneric().
+    // (Larger constants take long shift-and-add chains, which measured no faster than the multiply.)
+    // Every kernel is compiled for SSE2, AVX2 and AVX-512, and the best one for this CPU is picked when the program loads.
+    void scale(const std::int32_t* in, std::int32_t* out, std::size_t count, std::int32_t factor);
+
+    // The plain multiply loop, for factors without a kernel (and to compare against).
+    void scaleGeneric(const std::int32_t* in, std::int32_t* out, std::size_t count, std::int32_t factor);
+
+    bool hasScaleKernel(std::int32_t factor);
+}
+
+#endif
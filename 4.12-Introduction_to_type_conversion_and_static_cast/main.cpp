@@ -87,4 +87,25 @@ int main()
 /*
     If the destination type is unsigned, the value will be modulo wrapped.
     If the destination type is signed, the value is implementation-defined prior to C++20, and will be modulo wrapped as of C++20.
-*/
\ No newline at end of file
+*/
+/*------------------------------------------*/
+// CONVERTING VALUES THAT ARE CALCULATED AT COMPILE TIME
+// static_cast works just as well on values the compiler works out itself. The chapter 4 quiz calculator can evaluate a whole formula while compiling
+// (see ../4.x-Chapter_4_summary_and_quiz/fixedExpression.h, which needs C++20), so the program below carries only the results, and static_assert can check them:
+#if 0
+#include "../4.x-Chapter_4_summary_and_quiz/fixedExpression.h"
+#include <iostream>
+void print(int x)
+{
+    std::cout << x << '\n';
+}
+int main()
+{
+    constexpr double average{ calculator::calculate<"(4 + 5 + 8) / 3">() };
+    static_assert(static_cast<int>(average) == 5);
+
+    print(static_cast<int>(average));                                     // prints 5: the fraction is dropped
+    print(static_cast<int>(calculator::calculate<"floor(x * 2.5)">(3)));  // prints 7
+    return 0;
+}
+#endif
@@ -0,0 +1,114 @@
+#include "arena.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+#if defined(__SANITIZE_ADDRESS__)
+#include <sanitizer/asan_interface.h>
+#define ARENA_POISON(pointer, size) ASAN_POISON_MEMORY_REGION(pointer, size)
+#define ARENA_UNPOISON(pointer, size) ASAN_UNPOISON_MEMORY_REGION(pointer, size)
+#else
+#define ARENA_POISON(pointer, size) static_cast<void>(0)
+#define ARENA_UNPOISON(pointer, size) static_cast<void>(0)
+#endif
+
+namespace
+{
+#ifndef NDEBUG
+    constexpr unsigned char uninitializedByte{ 0xCD };
+    constexpr unsigned char freedByte{ 0xDD };
+#endif
+}
+
+Arena::Arena(std::size_t blockSize)
+    : m_blockSize{ blockSize }
+{
+}
+
+Arena::~Arena()
+{
+    for (const Block& block : m_blocks)
+    {
+        ARENA_UNPOISON(block.memory, block.size);
+        ::operator delete(block.memory);
+    }
+}
+
+// Moves on to the next block that can hold minimumSize bytes, making one if there is none.
+void Arena::startBlock(std::size_t minimumSize)
+{
+    std::size_t next{ m_blocks.empty() ? 0 : m_current + 1 };
+    while (next < m_blocks.size() && m_blocks[next].size < minimumSize)
+        ++next;
+
+    if (next == m_blocks.size())
+    {
+        std::size_t size{ std::max(m_blockSize, minimumSize) };
+        m_blocks.push_back({ static_cast<char*>(::operator new(size)), size });
+        ARENA_POISON(m_blocks.back().memory, size);
+    }
+    else if (next != m_current + 1)
+    {
+        // Keep the blocks in the order they are used, so the next reset() walks them the same way.
+        std::swap(m_blocks[m_current + 1], m_blocks[next]);
+        next = m_current + 1;
+    }
+
+    m_current = next;
+    m_next = m_blocks[m_current].memory;
+    m_end = m_next + m_blocks[m_current].size;
+}
+
+void* Arena::allocate(std::size_t size, std::size_t alignment)
+{
+    std::uintptr_t address{ reinterpret_cast<std::uintptr_t>(m_next) };
+    std::uintptr_t aligned{ (address + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1) };
+
+    if (m_next == nullptr || size > static_cast<std::size_t>(m_end - m_next) || aligned - address > static_cast<std::size_t>(m_end - m_next) - size)
+    {
+        startBlock(size + alignment);
+        address = reinterpret_cast<std::uintptr_t>(m_next);
+        aligned = (address + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+    }
+
+    char* pointer{ reinterpret_cast<char*>(aligned) };
+    m_next = pointer + size;
+
+    ARENA_UNPOISON(pointer, size);
+#ifndef NDEBUG
+    std::memset(pointer, uninitializedByte, size);
+#endif
+    return pointer;
+}
+
+void Arena::deallocate([[maybe_unused]] void* pointer, [[maybe_unused]] std::size_t size)
+{
+#ifndef NDEBUG
+    std::memset(pointer, freedByte, size);
+#endif
+    ARENA_POISON(pointer, size);
+}
+
+void Arena::reset()
+{
+    if (m_blocks.empty())
+        return;
+
+#ifndef NDEBUG
+    for (std::size_t i{ 0 }; i <= m_current; ++i)
+    {
+        ARENA_UNPOISON(m_blocks[i].memory, m_blocks[i].size);
+        std::memset(m_blocks[i].memory, freedByte, m_blocks[i].size);
+    }
+#endif
+
+    for (std::size_t i{ 0 }; i <= m_current; ++i)
+        ARENA_POISON(m_blocks[i].memory, m_blocks[i].size);
+
+    m_current = 0;
+    m_next = m_blocks[0].memory;
+    m_end = m_next + m_blocks[0].size;
+}
@@ -0,0 +1,634 @@
+// Micro-benchmarks for the calculator, so that performance claims can be checked on the machine at hand.
+// Usage: benchmark.out [suite...]
+// Without arguments every suite runs. Each measurement is the best of several runs.
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "calculator.h"
+#include "decimal.h"
+#include "halfFloat.h"
+#include "identifiers.h"
+#include "resultCache.h"
+#include "summation.h"
+
+namespace
+{
+    constexpr int runsPerMeasurement{ 5 };
+
+    // Stops the optimizer from deleting work whose result is never looked at.
+    volatile std::uint64_t sink{};
+
+    template <typename Function>
+    double bestNanosecondsPerElement(std::size_t elements, Function function)
+    {
+        double best{ 0.0 };
+
+        for (int run{ 0 }; run < runsPerMeasurement; ++run)
+        {
+            auto start{ std::chrono::steady_clock::now() };
+            function();
+            std::chrono::duration<double, std::nano> elapsed{ std::chrono::steady_clock::now() - start };
+
+            double perElement{ elapsed.count() / static_cast<double>(elements) };
+            if (run == 0 || perElement < best)
+                best = perElement;
+        }
+
+        return best;
+    }
+
+    void report(const char* name, double nanoseconds, double baseline, const char* unit)
+    {
+        std::cout << "  " << std::left << std::setw(44) << name << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(9) << nanoseconds << " ns/" << unit << std::setw(9) << std::setprecision(2) << nanoseconds / baseline << "x\n";
+    }
+
+    // Expression text with a realistic mix of identifiers: mostly variable names, plus function calls and the odd keyword.
+    std::string randomExpression(std::size_t identifiers, std::uint32_t seed)
+    {
+        static constexpr std::string_view names[]{ "x", "y", "price", "count", "total", "rate", "x2", "speed", "interest", "width", "height", "a_b" };
+
+        std::mt19937 random{ seed };
+        std::string text{};
+
+        for (std::size_t i{ 0 }; i < identifiers; ++i)
+        {
+            if (i > 0)
+                text += (random() % 2) ? " + " : " * ";
+
+            std::uint32_t pick{ static_cast<std::uint32_t>(random() % 10) };
+            if (pick < 6)
+                text += names[random() % std::size(names)];
+            else if (pick < 9)
+                text += std::string{ calculator::functions[random() % std::size(calculator::functions)].name } + "(";
+            else
+                text += calculator::keywords[random() % std::size(calculator::keywords)];
+
+            if (pick >= 6 && pick < 9)
+                text += "2)";
+        }
+
+        return text;
+    }
+
+    bool isIdentifierStart(char c)
+    {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+    }
+
+    bool isIdentifierCharacter(char c)
+    {
+        return isIdentifierStart(c) || (c >= '0' && c <= '9');
+    }
+
+    // Scans text the way the calculator's tokenizer does and hands every identifier to classify. Returns a checksum of the results.
+    template <typename Classify>
+    std::uint64_t tokenize(std::string_view text, Classify classify)
+    {
+        std::uint64_t checksum{ 0 };
+        std::size_t position{ 0 };
+
+        while (position < text.size())
+        {
+            if (!isIdentifierStart(text[position]))
+            {
+                ++position;
+                continue;
+            }
+
+            std::size_t start{ position };
+            while (position < text.size() && isIdentifierCharacter(text[position]))
+                ++position;
+
+            checksum = checksum * 3 + static_cast<std::uint64_t>(classify(text.substr(start, position - start)));
+        }
+
+        return checksum;
+    }
+
+    // What the calculator did before: compare against every function name (and here, every keyword too).
+    calculator::IdentifierKind classifyLinearly(std::string_view name)
+    {
+        for (const calculator::Function& function : calculator::functions)
+        {
+            if (function.name == name)
+                return calculator::IdentifierKind::function;
+        }
+
+        for (std::string_view keyword : calculator::keywords)
+        {
+            if (keyword == name)
+                return calculator::IdentifierKind::keyword;
+        }
+
+        return calculator::IdentifierKind::name;
+    }
+
+    void benchmarkTokenizer()
+    {
+        constexpr std::size_t identifiers{ 1 << 20 };
+        std::string text{ randomExpression(identifiers, 1) };
+
+        std::map<std::string, calculator::IdentifierKind, std::less<>> ordered{};
+        std::unordered_map<std::string_view, calculator::IdentifierKind> hashed{};
+        for (const calculator::Function& function : calculator::functions)
+        {
+            ordered.emplace(function.name, calculator::IdentifierKind::function);
+            hashed.emplace(function.name, calculator::IdentifierKind::function);
+        }
+
+        for (std::string_view keyword : calculator::keywords)
+        {
+            ordered.emplace(keyword, calculator::IdentifierKind::keyword);
+            hashed.emplace(keyword, calculator::IdentifierKind::keyword);
+        }
+
+        std::cout << "tokenizer (" << identifiers << " identifiers, " << std::size(calculator::functions) << " functions and "
+                  << std::size(calculator::keywords) << " keywords to recognise)\n";
+
+        std::uint64_t expected{ tokenize(text, [](std::string_view name) { return calculator::classifyIdentifier(name).kind; }) };
+
+        double scanOnly{ bestNanosecondsPerElement(identifiers, [&]
+        {
+            sink = sink + tokenize(text, [](std::string_view name) { return name.size(); });
+        }) };
+
+        double linear{ bestNanosecondsPerElement(identifiers, [&]
+        {
+            std::uint64_t checksum{ tokenize(text, classifyLinearly) };
+            sink = sink + (checksum == expected);
+        }) };
+
+        double map{ bestNanosecondsPerElement(identifiers, [&]
+        {
+            std::uint64_t checksum{ tokenize(text, [&](std::string_view name)
+            {
+                auto found{ ordered.find(name) };
+                return found == ordered.end() ? calculator::IdentifierKind::name : found->second;
+            }) };
+            sink = sink + (checksum == expected);
+        }) };
+
+        double unorderedMap{ bestNanosecondsPerElement(identifiers, [&]
+        {
+            std::uint64_t checksum{ tokenize(text, [&](std::string_view name)
+            {
+                auto found{ hashed.find(name) };
+                return found == hashed.end() ? calculator::IdentifierKind::name : found->second;
+            }) };
+            sink = sink + (checksum == expected);
+        }) };
+
+        double perfect{ bestNanosecondsPerElement(identifiers, [&]
+        {
+            std::uint64_t checksum{ tokenize(text, [](std::string_view name) { return calculator::classifyIdentifier(name).kind; }) };
+            sink = sink + (checksum == expected);
+        }) };
+
+        report("scanning only", scanOnly, scanOnly, "identifier");
+        report("scan + linear string compares", linear, scanOnly, "identifier");
+        report("scan + std::map", map, scanOnly, "identifier");
+        report("scan + std::unordered_map", unorderedMap, scanOnly, "identifier");
+        report("scan + perfect hash", perfect, scanOnly, "identifier");
+        std::cout << "  classification alone: linear " << std::setprecision(2) << linear - scanOnly << " ns, std::map " << map - scanOnly
+                  << " ns, std::unordered_map " << unorderedMap - scanOnly << " ns, perfect hash " << perfect - scanOnly << " ns per identifier\n";
+    }
+
+    // Evaluating rows that repeat a lot, directly and through a ResultCache, from several threads at once.
+    void benchmarkCache()
+    {
+        constexpr std::size_t rowsPerThread{ 1 << 18 };
+        constexpr std::size_t distinctRows{ 4096 };
+        constexpr unsigned threadCount{ 4 };
+
+        calculator::Program program{};
+        calculator::CompileError error{};
+        calculator::compile("pow(x, 0.37) * exp(y / 7) + sin(x) * cos(y) + log(x + 1)", program, error);
+
+        // Row i of each thread's stream is one of the distinct rows, the low ones much more often than the high ones.
+        std::vector<std::vector<double>> rows(threadCount);
+        for (unsigned t{ 0 }; t < threadCount; ++t)
+        {
+            std::mt19937 random{ t + 1 };
+            for (std::size_t i{ 0 }; i < rowsPerThread; ++i)
+            {
+                std::uint32_t key{ static_cast<std::uint32_t>((random() % distinctRows) * (random() % distinctRows) / distinctRows) };
+                rows[t].push_back(key % 64);
+                rows[t].push_back(key / 64);
+            }
+        }
+
+        std::cout << "cache (" << threadCount << " threads x " << rowsPerThread << " rows, " << distinctRows << " distinct rows, "
+                  << std::thread::hardware_concurrency() << " cores)\n";
+
+        auto runThreads{ [&](auto evaluateStream)
+        {
+            std::vector<std::thread> workers{};
+            for (unsigned t{ 0 }; t < threadCount; ++t)
+                workers.emplace_back(evaluateStream, std::cref(rows[t]));
+
+            for (std::thread& worker : workers)
+                worker.join();
+        } };
+
+        double direct{ bestNanosecondsPerElement(rowsPerThread * threadCount, [&]
+        {
+            runThreads([&](const std::vector<double>& stream)
+            {
+                calculator::Evaluator evaluator{ program };
+                double sum{ 0.0 };
+                for (std::size_t i{ 0 }; i < stream.size(); i += 2)
+                    sum += evaluator.evaluate(&stream[i]);
+                sink = sink + static_cast<std::uint64_t>(sum);
+            });
+        }) };
+        report("Evaluator", direct, direct, "row");
+
+        for (std::size_t shards : { std::size_t{ 1 }, std::size_t{ 16 } })
+        {
+            for (std::size_t capacity : { distinctRows / 8, distinctRows })
+            {
+                calculator::ResultCache cache{ capacity, shards };
+                double cached{ bestNanosecondsPerElement(rowsPerThread * threadCount, [&]
+                {
+                    runThreads([&](const std::vector<double>& stream)
+                    {
+                        calculator::CachedEvaluator evaluator{ program, cache };
+                        double sum{ 0.0 };
+                        for (std::size_t i{ 0 }; i < stream.size(); i += 2)
+                            sum += evaluator.evaluate(&stream[i]);
+                        sink = sink + static_cast<std::uint64_t>(sum);
+                    });
+                }) };
+
+                calculator::ResultCache::Statistics statistics{ cache.statistics() };
+                std::string name{ "CachedEvaluator, " + std::to_string(shards) + " shard(s), " + std::to_string(capacity) + " entries" };
+                report(name.c_str(), cached, direct, "row");
+                std::cout << "      hit rate " << std::setprecision(1) << 100.0 * static_cast<double>(statistics.hits) / static_cast<double>(statistics.hits + statistics.misses)
+                          << "%, " << statistics.evictions << " evictions\n";
+            }
+        }
+    }
+
+    // Compiling many short expressions, the case the compiler's arena is for: per expression, the tree and the optimizer's tables
+    // come from one thread-local arena that is reset afterwards, instead of from the allocator node by node.
+    void benchmarkCompile()
+    {
+        constexpr std::size_t expressionCount{ 4096 };
+
+        std::vector<std::string> expressions{};
+        std::mt19937 random{ 7 };
+        for (std::size_t i{ 0 }; i < expressionCount; ++i)
+        {
+            std::string text{ randomExpression(4 + random() % 12, static_cast<std::uint32_t>(i)) };
+
+            // Keep only those that compile, so that every measurement does the whole job.
+            calculator::Program program{};
+            calculator::CompileError error{};
+            if (calculator::compile(text, program, error))
+                expressions.push_back(text);
+        }
+
+        std::cout << "compile (" << expressions.size() << " expressions of 4 to 15 identifiers)\n";
+
+        double unoptimized{ bestNanosecondsPerElement(expressions.size(), [&]
+        {
+            for (const std::string& text : expressions)
+            {
+                calculator::Program program{};
+                calculator::CompileError error{};
+                sink = sink + calculator::compile(text, program, error, false);
+            }
+        }) };
+
+        double optimized{ bestNanosecondsPerElement(expressions.size(), [&]
+        {
+            for (const std::string& text : expressions)
+            {
+                calculator::Program program{};
+                calculator::CompileError error{};
+                sink = sink + calculator::compile(text, program, error);
+            }
+        }) };
+
+        report("compile", unoptimized, unoptimized, "expression");
+        report("compile and optimize", optimized, unoptimized, "expression");
+    }
+
+    // A column of prices: summing, taxing, parsing and printing them as doubles against Decimal<2>.
+    void benchmarkDecimal()
+    {
+        using Money = calculator::Decimal<2>;
+        constexpr std::size_t rows{ 1 << 20 };
+
+        std::mt19937 random{ 11 };
+        std::vector<std::string> texts(rows);
+        std::vector<double> doubles(rows);
+        std::vector<Money> amounts(rows);
+        for (std::size_t i{ 0 }; i < rows; ++i)
+        {
+            std::int64_t cents{ static_cast<std::int64_t>(random() % 1000000) };
+            amounts[i] = Money::fromRaw(cents);
+            char buffer[calculator::maxDecimalLength]{};
+            texts[i].assign(buffer, calculator::formatDecimal(buffer, amounts[i]));
+            std::from_chars(texts[i].data(), texts[i].data() + texts[i].size(), doubles[i]);
+        }
+
+        double doubleTotal{};
+        double doubleSum{ bestNanosecondsPerElement(rows, [&]
+        {
+            doubleTotal = 0.0;
+            for (double value : doubles)
+                doubleTotal += value;
+            sink = sink + static_cast<std::uint64_t>(doubleTotal);
+        }) };
+
+        Money total{};
+        double decimalSum{ bestNanosecondsPerElement(rows, [&]
+        {
+            total = calculator::sumColumn(amounts.data(), rows);
+            sink = sink + static_cast<std::uint64_t>(total.raw());
+        }) };
+
+        char buffer[calculator::maxDecimalLength]{};
+        std::cout << "decimal (" << rows << " amounts with 2 places; the double total is " << std::fixed << std::setprecision(6) << doubleTotal
+                  << ", the exact one " << std::string_view{ buffer, static_cast<std::size_t>(calculator::formatDecimal(buffer, total) - buffer) } << ")\n";
+        report("sum, double", doubleSum, doubleSum, "row");
+        report("sum, Decimal<2> column", decimalSum, doubleSum, "row");
+
+        std::vector<double> doubleTaxed(rows);
+        double doubleTax{ bestNanosecondsPerElement(rows, [&]
+        {
+            for (std::size_t i{ 0 }; i < rows; ++i)
+                doubleTaxed[i] = doubles[i] * 0.21;
+            sink = sink + static_cast<std::uint64_t>(doubleTaxed.back());
+        }) };
+
+        std::vector<Money> taxed(rows);
+        double decimalTax{ bestNanosecondsPerElement(rows, [&]
+        {
+            calculator::multiplyColumn(amounts.data(), Money::fromRaw(21), taxed.data(), rows);
+            sink = sink + static_cast<std::uint64_t>(taxed.back().raw());
+        }) };
+        report("times 0.21, double", doubleTax, doubleTax, "row");
+        report("times 0.21 rounded, Decimal<2> column", decimalTax, doubleTax, "row");
+
+        double doubleParse{ bestNanosecondsPerElement(rows, [&]
+        {
+            double value{};
+            for (const std::string& text : texts)
+            {
+                std::from_chars(text.data(), text.data() + text.size(), value);
+                sink = sink + static_cast<std::uint64_t>(value);
+            }
+        }) };
+
+        double decimalParse{ bestNanosecondsPerElement(rows, [&]
+        {
+            Money value{};
+            for (const std::string& text : texts)
+            {
+                calculator::parseDecimal(text, value);
+                sink = sink + static_cast<std::uint64_t>(value.raw());
+            }
+        }) };
+        report("parse, from_chars double", doubleParse, doubleParse, "row");
+        report("parse, parseDecimal", decimalParse, doubleParse, "row");
+
+        double doubleFormat{ bestNanosecondsPerElement(rows, [&]
+        {
+            char text[32]{};
+            for (double value : doubles)
+            {
+                std::to_chars_result result{ std::to_chars(text, text + sizeof(text), value, std::chars_format::fixed, 2) };
+                sink = sink + static_cast<std::uint64_t>(result.ptr - text);
+            }
+        }) };
+
+        double decimalFormat{ bestNanosecondsPerElement(rows, [&]
+        {
+            char text[calculator::maxDecimalLength]{};
+            for (Money value : amounts)
+                sink = sink + static_cast<std::uint64_t>(calculator::formatDecimal(text, value) - text);
+        }) };
+        report("format, to_chars double (fixed, 2)", doubleFormat, doubleFormat, "row");
+        report("format, formatDecimal", decimalFormat, doubleFormat, "row");
+    }
+
+    // How far result is from the exact sum, in units in the last place of the exact sum.
+    double ulpsOff(double result, double exact)
+    {
+        double ulp{ std::nextafter(std::fabs(exact), HUGE_VAL) - std::fabs(exact) };
+        return std::fabs(result - exact) / ulp;
+    }
+
+    // A loop adding one value after the other, in double and in long double, against the three ways calculator::sum() adds them,
+    // on a column that stays in the cache and on one that does not fit any cache. The values have both signs and six orders of magnitude.
+    void benchmarkSum()
+    {
+        for (std::size_t size : { std::size_t{ 1 } << 12, std::size_t{ 1 } << 23 })
+        {
+            std::mt19937 random{ 13 };
+            std::normal_distribution<double> normal{};
+            std::vector<double> values(size);
+            for (double& value : values)
+                value = normal(random) * std::pow(10.0, static_cast<double>(random() % 7) - 3.0);
+
+            std::vector<float> floats(values.begin(), values.end());
+            std::size_t repetitions{ (std::size_t{ 1 } << 24) / size };
+
+            for (bool single : { false, true })
+            {
+                double exact{ single ? calculator::sum(floats.data(), size, calculator::Summation::exact) : calculator::sum(values.data(), size, calculator::Summation::exact) };
+                std::cout << "sum (" << size << (single ? " floats" : " doubles") << ", " << std::thread::hardware_concurrency() << " cores; each line gives how far its sum is from the exact one)\n";
+
+                auto measure{ [&](const char* name, auto add, double baseline)
+                {
+                    double result{};
+                    double time{ bestNanosecondsPerElement(size * repetitions, [&]
+                    {
+                        for (std::size_t i{ 0 }; i < repetitions; ++i)
+                            result = add();
+                        sink = sink + static_cast<std::uint64_t>(std::fabs(result));
+                    }) };
+
+                    std::string label{ std::string{ name } + ", " + std::to_string(static_cast<long long>(std::round(ulpsOff(result, exact)))) + " ulp off" };
+                    report(label.c_str(), time, baseline == 0.0 ? time : baseline, "value");
+                    return time;
+                } };
+
+                // The loops accumulate in the column's own type, as code written without thinking about it would.
+                double loop{ measure("loop", [&]
+                {
+                    if (single)
+                    {
+                        float total{ 0.0f };
+                        for (float value : floats)
+                            total += value;
+                        return static_cast<double>(total);
+                    }
+
+                    double total{ 0.0 };
+                    for (double value : values)
+                        total += value;
+                    return total;
+                }, 0.0) };
+
+                measure("loop, long double", [&]
+                {
+                    long double total{ 0.0L };
+                    for (std::size_t i{ 0 }; i < size; ++i)
+                        total += single ? floats[i] : values[i];
+                    return static_cast<double>(total);
+                }, loop);
+
+                for (auto [name, method] : { std::pair{ "sum, pairwise", calculator::Summation::pairwise }, std::pair{ "sum, compensated", calculator::Summation::compensated },
+                                             std::pair{ "sum, exact", calculator::Summation::exact } })
+                {
+                    measure(name, [&] { return single ? calculator::sum(floats.data(), size, method) : calculator::sum(values.data(), size, method); }, loop);
+                }
+            }
+        }
+    }
+
+    // What storing a float column as Float16 or BFloat16 costs in precision, printed with setprecision(9) as in lesson 4.8,
+    // and what the conversions cost in time, against copying the floats.
+    void benchmarkHalf()
+    {
+        std::cout << "half (the values from lesson 4.8, as float, Float16 and BFloat16)\n" << std::setprecision(9) << std::defaultfloat;
+        for (float value : { 9.87654321f, 987.654321f, 987654.321f, 9876543.21f, 0.0000987654321f, 3.33333333f, 123456789.0f, 0.1f })
+        {
+            std::cout << "  " << std::left << std::setw(16) << value << std::setw(16) << static_cast<float>(calculator::Float16{ value })
+                      << static_cast<float>(calculator::BFloat16{ value }) << std::right << '\n';
+        }
+
+        // Measurements from 0.001 to 1000, so that all of them are normal Float16s.
+        constexpr std::size_t size{ 1 << 22 };
+        std::mt19937 random{ 17 };
+        std::uniform_real_distribution<float> exponent{ -3.0f, 3.0f };
+        std::vector<float> values(size);
+        for (float& value : values)
+            value = std::pow(10.0f, exponent(random)) * ((random() % 2) ? 1.0f : -1.0f);
+
+        std::vector<calculator::Float16> halves(size);
+        std::vector<calculator::BFloat16> brainHalves(size);
+        std::vector<float> back(size);
+
+        auto relativeErrors{ [&](const char* name)
+        {
+            double largest{ 0.0 };
+            double total{ 0.0 };
+            for (std::size_t i{ 0 }; i < size; ++i)
+            {
+                double error{ std::fabs(static_cast<double>(back[i]) - values[i]) / std::fabs(static_cast<double>(values[i])) };
+                largest = std::max(largest, error);
+                total += error;
+            }
+
+            std::cout << "  " << std::left << std::setw(10) << name << std::right << std::scientific << std::setprecision(2) << "largest relative error "
+                      << largest << ", mean " << total / size << std::defaultfloat << std::setprecision(2) << " (" << -std::log10(largest) << " digits for sure)\n";
+        } };
+
+        std::cout << "half (" << size << " floats from 0.001 to 1000; Float16 conversions dispatch to " << calculator::float16ImplementationName() << ")\n";
+        calculator::toFloat16(values.data(), halves.data(), size);
+        calculator::toFloat(halves.data(), back.data(), size);
+        relativeErrors("Float16");
+        calculator::toBFloat16(values.data(), brainHalves.data(), size);
+        calculator::toFloat(brainHalves.data(), back.data(), size);
+        relativeErrors("BFloat16");
+
+        double copy{ bestNanosecondsPerElement(size, [&]
+        {
+            std::copy(values.begin(), values.end(), back.begin());
+            sink = sink + std::bit_cast<std::uint32_t>(back.back());
+        }) };
+
+        double scalar{ bestNanosecondsPerElement(size, [&]
+        {
+            for (std::size_t i{ 0 }; i < size; ++i)
+                halves[i] = calculator::Float16{ values[i] };
+            sink = sink + halves.back().bits();
+        }) };
+
+        double toHalf{ bestNanosecondsPerElement(size, [&]
+        {
+            calculator::toFloat16(values.data(), halves.data(), size);
+            sink = sink + halves.back().bits();
+        }) };
+
+        double fromHalf{ bestNanosecondsPerElement(size, [&]
+        {
+            calculator::toFloat(halves.data(), back.data(), size);
+            sink = sink + std::bit_cast<std::uint32_t>(back.back());
+        }) };
+
+        double toBrainHalf{ bestNanosecondsPerElement(size, [&]
+        {
+            calculator::toBFloat16(values.data(), brainHalves.data(), size);
+            sink = sink + brainHalves.back().bits();
+        }) };
+
+        double fromBrainHalf{ bestNanosecondsPerElement(size, [&]
+        {
+            calculator::toFloat(brainHalves.data(), back.data(), size);
+            sink = sink + std::bit_cast<std::uint32_t>(back.back());
+        }) };
+
+        report("copy floats", copy, copy, "value");
+        report("float to Float16, one at a time", scalar, copy, "value");
+        report("toFloat16", toHalf, copy, "value");
+        report("toFloat from Float16", fromHalf, copy, "value");
+        report("toBFloat16", toBrainHalf, copy, "value");
+        report("toFloat from BFloat16", fromBrainHalf, copy, "value");
+    }
+
+    struct Suite
+    {
+        const char* name;
+        void (*run)();
+    };
+
+    constexpr Suite suites[]{
+        { "tokenizer", benchmarkTokenizer },
+        { "cache", benchmarkCache },
+        { "compile", benchmarkCompile },
+        { "decimal", benchmarkDecimal },
+        { "sum", benchmarkSum },
+        { "half", benchmarkHalf },
+    };
+}
+
+int main(int argc, char* argv[])
+{
+    for (const Suite& suite : suites)
+    {
+        bool selected{ argc == 1 };
+        for (int i{ 1 }; i < argc; ++i)
+        {
+            if (std::strcmp(argv[i], suite.name) == 0)
+                selected = true;
+        }
+
+        if (selected)
+            suite.run();
+    }
+
+    return 0;
+}
@@ -0,0 +1,785 @@
+#include "calculator.h"
+#include "arena.h"
+#include "identifiers.h"
+#include "inputReader.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+// GCC and Clang can jump straight to the code for the next instruction through a table of label addresses ("computed goto").
+// That saves the bounds check and the shared indirect jump of a switch, which matters when the same few instructions run millions of times.
+#if defined(__GNUC__)
+#define CALCULATOR_COMPUTED_GOTO
+#endif
+
+// The block kernels are compiled once per instruction set and the best one for this CPU is picked when the program loads.
+// (CMakeLists.txt builds this file with -fno-math-errno -fno-trapping-math, without which sqrt, floor and ceil would stay scalar.)
+#if defined(__GNUC__) && defined(__x86_64__) && defined(__ELF__)
+#define CALCULATOR_BLOCK_KERNEL __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define CALCULATOR_BLOCK_KERNEL
+#endif
+
+namespace calculator
+{
+    namespace
+    {
+        enum class NodeKind : std::uint8_t
+        {
+            constant,
+            variable,
+            operation,
+        };
+
+        // The parsed expression is a tree stored in one vector. Children are always added before their parent, so the vector is already in evaluation order.
+        struct Node
+        {
+            NodeKind kind{};
+            OpCode op{};
+            std::uint32_t left{};
+            std::uint32_t right{};
+            double value{};          // For constants.
+            std::uint32_t variable{}; // For variables: the index into Program::variables().
+        };
+
+        // True if value is plus or minus a power of two whose reciprocal is also an ordinary double, so x / value == x * (1 / value) exactly.
+        bool hasExactReciprocal(double value)
+        {
+            int exponent{};
+            double mantissa{ std::frexp(value, &exponent) };
+            return (mantissa == 0.5 || mantissa == -0.5) && std::isnormal(value) && std::isnormal(1.0 / value);
+        }
+
+        // Runs one instruction over a whole block. Every case is a plain loop of a fixed length over unaliased arrays, which vectorizes.
+        // exp, log, sin, cos, tan and pow have no vector instruction, so they stay a loop of library calls.
+        CALCULATOR_BLOCK_KERNEL
+        void runBlockInstruction(OpCode op, const double* __restrict left, const double* __restrict right, double* __restrict out)
+        {
+            switch (op)
+            {
+            case OpCode::add:
+                for (std::size_t i{ 0 }; i < blockSize; ++i)
+                    out[i] = left[i] + right[i];
+                break;
+            case OpCode::subtract:
+                for (std::size_t i{ 0 }; i < blockSize; ++i)
+                    out[i] = left[i] - right[i];
+                break;
+            case OpCode::multiply:
+                for (std::size_t i{ 0 }; i < blockSize; ++i)
+                    out[i] = left[i] * right[i];
+                break;
+            case OpCode::divide:
+                for (std::size_t i{ 0 }; i < blockSize; ++i)
+                    out[i] = left[i] / right[i];
+                break;
+            case OpCode::negate:
+                for (std::size_t i{ 0 }; i < blockSize; ++i)
+                    out[i] = -left[i];
+                break;
+            case OpCode::squareRoot:
+                for (std::size_t i{ 0 }; i < blockSize; ++i)
+                    out[i] = std::sqrt(left[i]);
+                break;
+            case OpCode::absolute:
+                for (std::size_t i{ 0 }; i < blockSize; ++i)
+                    out[i] = std::fabs(left[i]);
+                break;
+            case OpCode::exponential:
+                for (std::size_t i{ 0 }; i < blockSize; ++i)
+                    out[i] = std::exp(left[i]);
+                break;
+            case OpCode::logarithm:
+                for (std::size_t i{ 0 }; i < blockSize; ++i)
+                    out[i] = std::log(left[i]);
+                break;
+            case OpCode::sine:
+                for (std::size_t i{ 0 }; i < blockSize; ++i)
+                    out[i] = std::sin(left[i]);
+                break;
+            case OpCode::cosine:
+                for (std::size_t i{ 0 }; i < blockSize; ++i)
+                    out[i] = std::cos(left[i]);
+                break;
+            case OpCode::tangent:
+                for (std::size_t i{ 0 }; i < blockSize; ++i)
+                    out[i] = std::tan(left[i]);
+                break;
+            case OpCode::floor:
+                for (std::size_t i{ 0 }; i < blockSize; ++i)
+                    out[i] = std::floor(left[i]);
+                break;
+            case OpCode::ceil:
+                for (std::size_t i{ 0 }; i < blockSize; ++i)
+                    out[i] = std::ceil(left[i]);
+                break;
+            case OpCode::power:
+                for (std::size_t i{ 0 }; i < blockSize; ++i)
+                    out[i] = std::pow(left[i], right[i]);
+                break;
+            case OpCode::minimum:
+                for (std::size_t i{ 0 }; i < blockSize; ++i)
+                    out[i] = minimum(left[i], right[i]);
+                break;
+            case OpCode::maximum:
+                for (std::size_t i{ 0 }; i < blockSize; ++i)
+                    out[i] = maximum(left[i], right[i]);
+                break;
+            case OpCode::halt:
+                break;
+            }
+        }
+
+        // The compiler's working memory (the tree, the optimizer's tables) comes from an arena, so compiling a short expression
+        // costs a few pointer bumps instead of a trip to the allocator per node, and all of it is released at once afterwards.
+        template <typename T>
+        using ScratchVector = std::vector<T, ArenaAllocator<T>>;
+
+        // One arena per thread, reset after every compile.
+        Arena& scratchArena()
+        {
+            thread_local Arena arena{};
+            return arena;
+        }
+
+        bool isIdentifierStart(char c)
+        {
+            return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+        }
+
+        bool isIdentifierCharacter(char c)
+        {
+            return isIdentifierStart(c) || (c >= '0' && c <= '9');
+        }
+    }
+
+    // Recursive descent parser for:
+    //     expression := term (('+' | '-') term)*
+    //     term       := unary (('*' | '/') unary)*
+    //     unary      := ('-' | '+') unary | primary
+    //     primary    := number | variable | function '(' expression (',' expression)* ')' | '(' expression ')'
+    class Compiler
+    {
+    public:
+        Compiler(std::string_view text, Program& program, CompileError& error, bool optimize, Arena& arena)
+            : m_text{ text }, m_program{ program }, m_error{ error }, m_optimize{ optimize }, m_arena{ arena }, m_nodes{ ArenaAllocator<Node>{ arena } }
+        {
+        }
+
+        bool run()
+        {
+            m_program = Program{};
+
+            std::uint32_t root{};
+            if (!parseExpression(root))
+                return false;
+
+            skipSpaces();
+            if (m_position != m_text.size())
+                return fail("Unexpected character");
+
+            if (m_optimize)
+            {
+                std::size_t parsedNodes{ m_nodes.size() };
+                root = optimize(root);
+                m_program.m_nodesRemoved = parsedNodes - m_nodes.size();
+            }
+
+            return generate(root);
+        }
+
+    private:
+        bool fail(std::string_view message)
+        {
+            m_error.message = message;
+            m_error.position = m_position;
+            return false;
+        }
+
+        void skipSpaces()
+        {
+            while (m_position < m_text.size() && (m_text[m_position] == ' ' || m_text[m_position] == '\t'))
+                ++m_position;
+        }
+
+        bool accept(char c)
+        {
+            skipSpaces();
+            if (m_position < m_text.size() && m_text[m_position] == c)
+            {
+                ++m_position;
+                return true;
+            }
+
+            return false;
+        }
+
+        std::uint32_t addNode(const Node& node)
+        {
+            m_nodes.push_back(node);
+            return static_cast<std::uint32_t>(m_nodes.size() - 1);
+        }
+
+        std::uint32_t addOperation(OpCode op, std::uint32_t left, std::uint32_t right)
+        {
+            Node node{};
+            node.kind = NodeKind::operation;
+            node.op = op;
+            node.left = left;
+            node.right = right;
+            return addNode(node);
+        }
+
+        bool parseExpression(std::uint32_t& result)
+        {
+            if (!parseTerm(result))
+                return false;
+
+            while (true)
+            {
+                OpCode op{};
+                if (accept('+'))
+                    op = OpCode::add;
+                else if (accept('-'))
+                    op = OpCode::subtract;
+                else
+                    return true;
+
+                std::uint32_t right{};
+                if (!parseTerm(right))
+                    return false;
+
+                result = addOperation(op, result, right);
+            }
+        }
+
+        bool parseTerm(std::uint32_t& result)
+        {
+            if (!parseUnary(result))
+                return false;
+
+            while (true)
+            {
+                OpCode op{};
+                if (accept('*'))
+                    op = OpCode::multiply;
+                else if (accept('/'))
+                    op = OpCode::divide;
+                else
+                    return true;
+
+                std::uint32_t right{};
+                if (!parseUnary(right))
+                    return false;
+
+                result = addOperation(op, result, right);
+            }
+        }
+
+        // Every level of nesting comes through here: a sign, or a '(' or function argument by way of parseExpression.
+        bool parseUnary(std::uint32_t& result)
+        {
+            if (m_depth == maxNesting)
+                return fail("Expression is nested too deeply");
+
+            ++m_depth;
+            bool parsed{ parseSigned(result) };
+            --m_depth;
+            return parsed;
+        }
+
+        bool parseSigned(std::uint32_t& result)
+        {
+            if (accept('-'))
+            {
+                if (!parseUnary(result))
+                    return false;
+
+                result = addOperation(OpCode::negate, result, result);
+                return true;
+            }
+
+            if (accept('+'))
+                return parseUnary(result);
+
+            return parsePrimary(result);
+        }
+
+        bool parsePrimary(std::uint32_t& result)
+        {
+            skipSpaces();
+            if (m_position == m_text.size())
+                return fail("Expected a number, a variable or '('");
+
+            char c{ m_text[m_position] };
+
+            if (c == '(')
+            {
+                ++m_position;
+                if (!parseExpression(result))
+                    return false;
+
+                return accept(')') || fail("Expected ')'");
+            }
+
+            if ((c >= '0' && c <= '9') || c == '.')
+                return parseNumber(result);
+
+            if (isIdentifierStart(c))
+                return parseIdentifier(result);
+
+            return fail("Expected a number, a variable or '('");
+        }
+
+        bool parseNumber(std::uint32_t& result)
+        {
+            Node node{};
+            node.kind = NodeKind::constant;
+
+            const char* first{ m_text.data() + m_position };
+            std::from_chars_result parsed{ std::from_chars(first, m_text.data() + m_text.size(), node.value) };
+            if (parsed.ec == std::errc::invalid_argument)
+                return fail("Invalid number");
+
+            // Out of range numbers become infinity (1e400) or 0 (1e-400), just as they would in a double.
+            if (parsed.ec == std::errc::result_out_of_range)
+                node.value = outOfRangeValue(first, parsed.ptr);
+
+            m_position += static_cast<std::size_t>(parsed.ptr - first);
+            result = addNode(node);
+            return true;
+        }
+
+        bool parseIdentifier(std::uint32_t& result)
+        {
+            std::size_t start{ m_position };
+            while (m_position < m_text.size() && isIdentifierCharacter(m_text[m_position]))
+                ++m_position;
+
+            std::string_view name{ m_text.substr(start, m_position - start) };
+            Identifier identifier{ classifyIdentifier(name) };
+
+            if (identifier.kind == IdentifierKind::keyword)
+            {
+                m_position = start;
+                return fail("A C++ keyword can not be used as a variable name");
+            }
+
+            if (const Function* function{ identifier.function })
+            {
+                if (!accept('('))
+                    return fail("Expected '(' after a function name");
+
+                std::uint32_t arguments[2]{};
+                for (int i{ 0 }; i < function->arity; ++i)
+                {
+                    if (i > 0 && !accept(','))
+                        return fail("Expected ','");
+
+                    if (!parseExpression(arguments[i]))
+                        return false;
+                }
+
+                if (!accept(')'))
+                    return fail(function->arity == 1 ? "Expected ')'" : "Expected ')' after the arguments");
+
+                result = addOperation(function->op, arguments[0], function->arity == 2 ? arguments[1] : arguments[0]);
+                return true;
+            }
+
+            Node node{};
+            node.kind = NodeKind::variable;
+
+            int index{ m_program.variableIndex(name) };
+            if (index < 0)
+            {
+                index = static_cast<int>(m_program.m_variables.size());
+                m_program.m_variables.emplace_back(name);
+            }
+
+            node.variable = static_cast<std::uint32_t>(index);
+            result = addNode(node);
+            return true;
+        }
+
+        // Rewrites the parsed tree, bottom up, into a smaller graph that computes exactly the same values:
+        //  - operations on constants only are replaced by their result (3 * 4 + x becomes 12 + x),
+        //  - identical subexpressions are kept once and shared (x*y + sqrt(x*y) computes x*y once); x + y and y + x count as identical,
+        //  - x * 1 and x / 1 become x, x * 2 becomes x + x, and dividing by a power of two becomes multiplying by its reciprocal.
+        // Returns the new root. m_nodes is left holding only the nodes the root still depends on.
+        std::uint32_t optimize(std::uint32_t root)
+        {
+            // Identifies a node by its contents. A constant's value is compared bit for bit, so 0 and -0 stay apart.
+            using NodeKey = std::tuple<NodeKind, OpCode, std::uint32_t, std::uint32_t, std::uint64_t>;
+
+            ScratchVector<Node> optimized{ ArenaAllocator<Node>{ m_arena } };
+            std::map<NodeKey, std::uint32_t, std::less<>, ArenaAllocator<std::pair<const NodeKey, std::uint32_t>>> existing{ ArenaAllocator<NodeKey>{ m_arena } };
+
+            auto addUnique{ [&](const Node& node) -> std::uint32_t
+            {
+                std::uint64_t bits{};
+                static_assert(sizeof(bits) == sizeof(node.value));
+                std::memcpy(&bits, &node.value, sizeof(bits));
+
+                NodeKey key{ node.kind, node.op, node.left, node.right, node.kind == NodeKind::variable ? node.variable : bits };
+                auto [position, inserted]{ existing.try_emplace(key, static_cast<std::uint32_t>(optimized.size())) };
+                if (inserted)
+                    optimized.push_back(node);
+
+                return position->second;
+            } };
+
+            auto addConstant{ [&](double value)
+            {
+                Node node{};
+                node.kind = NodeKind::constant;
+                node.value = value;
+                return addUnique(node);
+            } };
+
+            auto isConstant{ [&](std::uint32_t index, double value)
+            {
+                return optimized[index].kind == NodeKind::constant && optimized[index].value == value;
+            } };
+
+            ScratchVector<std::uint32_t> replacement(m_nodes.size(), 0, ArenaAllocator<std::uint32_t>{ m_arena });
+            for (std::size_t i{ 0 }; i < m_nodes.size(); ++i)
+            {
+                Node node{ m_nodes[i] };
+                if (node.kind != NodeKind::operation)
+                {
+                    replacement[i] = addUnique(node);
+                    continue;
+                }
+
+                node.left = replacement[node.left];
+                node.right = replacement[node.right];
+
+                Node left{ optimized[node.left] };
+                Node right{ optimized[node.right] };
+
+                if (left.kind == NodeKind::constant && right.kind == NodeKind::constant)
+                {
+                    replacement[i] = addConstant(applyOperation(node.op, left.value, right.value));
+                    continue;
+                }
+
+                if ((node.op == OpCode::multiply || node.op == OpCode::divide) && isConstant(node.right, 1.0))
+                {
+                    replacement[i] = node.left;
+                    continue;
+                }
+
+                if (node.op == OpCode::multiply && isConstant(node.left, 1.0))
+                {
+                    replacement[i] = node.right;
+                    continue;
+                }
+
+                if (node.op == OpCode::divide && right.kind == NodeKind::constant && hasExactReciprocal(right.value))
+                {
+                    node.op = OpCode::multiply;
+                    node.right = addConstant(1.0 / right.value);
+                }
+
+                if (node.op == OpCode::multiply && (isConstant(node.left, 2.0) || isConstant(node.right, 2.0)))
+                {
+                    node.op = OpCode::add;
+                    node.left = isConstant(node.left, 2.0) ? node.right : node.left;
+                    node.right = node.left;
+                }
+
+                if ((node.op == OpCode::add || node.op == OpCode::multiply) && node.left > node.right)
+                    std::swap(node.left, node.right);
+
+                replacement[i] = addUnique(node);
+            }
+
+            // Folding leaves constants (and shared nodes) behind that nothing uses any more. Keep only what the root depends on, in the same order.
+            ScratchVector<bool> used(optimized.size(), false, ArenaAllocator<bool>{ m_arena });
+            root = replacement[root];
+            used[root] = true;
+            for (std::size_t i{ optimized.size() }; i-- > 0;)
+            {
+                if (used[i] && optimized[i].kind == NodeKind::operation)
+                {
+                    used[optimized[i].left] = true;
+                    used[optimized[i].right] = true;
+                }
+            }
+
+            ScratchVector<std::uint32_t> position(optimized.size(), 0, ArenaAllocator<std::uint32_t>{ m_arena });
+            m_nodes.clear();
+            for (std::size_t i{ 0 }; i < optimized.size(); ++i)
+            {
+                if (!used[i])
+                    continue;
+
+                Node node{ optimized[i] };
+                node.left = position[node.left];
+                node.right = position[node.right];
+                position[i] = static_cast<std::uint32_t>(m_nodes.size());
+                m_nodes.push_back(node);
+            }
+
+            return position[root];
+        }
+
+        // Gives every node a register and emits one instruction per operation, in node order (children before parents).
+        bool generate(std::uint32_t root)
+        {
+            std::size_t constants{ 0 };
+            std::size_t operations{ 0 };
+            for (const Node& node : m_nodes)
+            {
+                if (node.kind == NodeKind::constant)
+                    ++constants;
+                else if (node.kind == NodeKind::operation)
+                    ++operations;
+            }
+
+            std::size_t registerCount{ constants + m_program.m_variables.size() + operations };
+            if (registerCount > std::numeric_limits<std::uint16_t>::max())
+                return fail("Expression is too long");
+
+            std::uint16_t firstVariable{ static_cast<std::uint16_t>(constants) };
+            std::uint16_t nextConstant{ 0 };
+            std::uint16_t nextOperation{ static_cast<std::uint16_t>(constants + m_program.m_variables.size()) };
+
+            m_program.m_initialRegisters.assign(registerCount, 0.0);
+            m_program.m_firstVariable = firstVariable;
+
+            ScratchVector<std::uint16_t> registers(m_nodes.size(), 0, ArenaAllocator<std::uint16_t>{ m_arena });
+            for (std::size_t i{ 0 }; i < m_nodes.size(); ++i)
+            {
+                const Node& node{ m_nodes[i] };
+                switch (node.kind)
+                {
+                case NodeKind::constant:
+                    registers[i] = nextConstant++;
+                    m_program.m_initialRegisters[registers[i]] = node.value;
+                    break;
+                case NodeKind::variable:
+                    registers[i] = static_cast<std::uint16_t>(firstVariable + node.variable);
+                    break;
+                case NodeKind::operation:
+                    registers[i] = nextOperation++;
+                    m_program.m_instructions.push_back({ node.op, registers[i], registers[node.left], registers[node.right] });
+                    break;
+                }
+            }
+
+            m_program.m_instructions.push_back({ OpCode::halt, 0, 0, 0 });
+            m_program.m_result = registers[root];
+            return true;
+        }
+
+        std::string_view m_text{};
+        std::size_t m_position{ 0 };
+        std::size_t m_depth{ 0 };
+        Program& m_program;
+        CompileError& m_error;
+        bool m_optimize{ true };
+        Arena& m_arena;
+        ScratchVector<Node> m_nodes;
+    };
+
+    int Program::variableIndex(std::string_view name) const
+    {
+        for (std::size_t i{ 0 }; i < m_variables.size(); ++i)
+        {
+            if (m_variables[i] == name)
+                return static_cast<int>(i);
+        }
+
+        return -1;
+    }
+
+    bool Program::hasSameCode(const Program& other) const
+    {
+        auto sameInstruction{ [](const Instruction& a, const Instruction& b)
+        {
+            return a.op == b.op && a.destination == b.destination && a.left == b.left && a.right == b.right;
+        } };
+
+        // Constants are compared bit for bit: 0 and -0 (or two different NaNs) are different programs.
+        auto sameBits{ [](double a, double b) { return std::memcmp(&a, &b, sizeof(a)) == 0; } };
+
+        return m_variables.size() == other.m_variables.size() && m_firstVariable == other.m_firstVariable && m_result == other.m_result
+            && std::equal(m_instructions.begin(), m_instructions.end(), other.m_instructions.begin(), other.m_instructions.end(), sameInstruction)
+            && std::equal(m_initialRegisters.begin(), m_initialRegisters.end(), other.m_initialRegisters.begin(), other.m_initialRegisters.end(), sameBits);
+    }
+
+    double Program::evaluate(const double* values, double* registers) const
+    {
+        std::copy(values, values + m_variables.size(), registers + m_firstVariable);
+
+        const Instruction* instruction{ m_instructions.data() };
+
+#ifdef CALCULATOR_COMPUTED_GOTO
+        // Must list a label for every OpCode, in the same order.
+        static const void* const labels[]{
+            &&add, &&subtract, &&multiply, &&divide, &&negate, &&squareRoot, &&absolute, &&exponential, &&logarithm,
+            &&sine, &&cosine, &&tangent, &&floor, &&ceil, &&power, &&minimum, &&maximum, &&halt,
+        };
+        static_assert(sizeof(labels) / sizeof(labels[0]) == static_cast<std::size_t>(OpCode::halt) + 1);
+
+#define CALCULATOR_OPERATION(label, expression)                       \
+    label:                                                             \
+    {                                                                  \
+        double left{ registers[instruction->left] };                   \
+        double right{ registers[instruction->right] };                 \
+        static_cast<void>(right);                                      \
+        registers[instruction->destination] = (expression);            \
+        ++instruction;                                                 \
+        goto* labels[static_cast<std::size_t>(instruction->op)];       \
+    }
+
+        goto* labels[static_cast<std::size_t>(instruction->op)];
+
+        CALCULATOR_OPERATION(add, left + right)
+        CALCULATOR_OPERATION(subtract, left - right)
+        CALCULATOR_OPERATION(multiply, left * right)
+        CALCULATOR_OPERATION(divide, left / right)
+        CALCULATOR_OPERATION(negate, -left)
+        CALCULATOR_OPERATION(squareRoot, std::sqrt(left))
+        CALCULATOR_OPERATION(absolute, std::fabs(left))
+        CALCULATOR_OPERATION(exponential, std::exp(left))
+        CALCULATOR_OPERATION(logarithm, std::log(left))
+        CALCULATOR_OPERATION(sine, std::sin(left))
+        CALCULATOR_OPERATION(cosine, std::cos(left))
+        CALCULATOR_OPERATION(tangent, std::tan(left))
+        CALCULATOR_OPERATION(floor, std::floor(left))
+        CALCULATOR_OPERATION(ceil, std::ceil(left))
+        CALCULATOR_OPERATION(power, std::pow(left, right))
+        CALCULATOR_OPERATION(minimum, minimum(left, right))
+        CALCULATOR_OPERATION(maximum, maximum(left, right))
+
+#undef CALCULATOR_OPERATION
+
+    halt:
+        return registers[m_result];
+#else
+        while (instruction->op != OpCode::halt)
+        {
+            registers[instruction->destination] = applyOperation(instruction->op, registers[instruction->left], registers[instruction->right]);
+            ++instruction;
+        }
+
+        return registers[m_result];
+#endif
+    }
+
+    Evaluator::Evaluator(const Program& program)
+        : m_program{ &program }, m_registers{ program.initialRegisters() }
+    {
+    }
+
+    BlockEvaluator::BlockEvaluator(const Program& program)
+        : m_program{ &program },
+          m_registers(program.m_initialRegisters.size() * blockSize),
+          m_sources(program.m_initialRegisters.size()),
+          m_partial(program.m_variables.size() * blockSize)
+    {
+        for (std::size_t r{ 0 }; r < m_sources.size(); ++r)
+        {
+            double* block{ m_registers.data() + r * blockSize };
+            std::fill(block, block + blockSize, program.m_initialRegisters[r]);
+            m_sources[r] = block;
+        }
+    }
+
+    void BlockEvaluator::evaluate(const double* const* columns, std::size_t count, double* results)
+    {
+        const Program& program{ *m_program };
+        std::size_t variables{ program.m_variables.size() };
+
+        for (std::size_t v{ 0 }; v < variables; ++v)
+        {
+            const double* column{ columns[v] };
+            if (count < blockSize)
+            {
+                double* padded{ m_partial.data() + v * blockSize };
+                std::copy(column, column + count, padded);
+                std::fill(padded + count, padded + blockSize, 0.0);
+                column = padded;
+            }
+
+            m_sources[program.m_firstVariable + v] = column;
+        }
+
+        for (const Instruction& instruction : program.m_instructions)
+        {
+            if (instruction.op == OpCode::halt)
+                break;
+
+            runBlockInstruction(instruction.op, m_sources[instruction.left], m_sources[instruction.right], m_registers.data() + instruction.destination * blockSize);
+        }
+
+        const double* result{ m_sources[program.m_result] };
+        std::copy(result, result + count, results);
+    }
+
+    namespace
+    {
+        void evaluateRows(const Program& program, const double* const* columns, std::size_t first, std::size_t last, double* results)
+        {
+            BlockEvaluator evaluator{ program };
+            std::vector<const double*> block(program.variables().size());
+
+            for (std::size_t row{ first }; row < last; row += blockSize)
+            {
+                for (std::size_t v{ 0 }; v < block.size(); ++v)
+                    block[v] = columns[v] + row;
+
+                evaluator.evaluate(block.data(), std::min(blockSize, last - row), results + row);
+            }
+        }
+    }
+
+    void evaluateColumns(const Program& program, const double* const* columns, std::size_t rows, double* results, unsigned threads)
+    {
+        if (threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+
+        // Every core gets one contiguous run of whole blocks. The main thread takes the first run itself.
+        std::size_t blocks{ (rows + blockSize - 1) / blockSize };
+        std::size_t blocksPerThread{ (blocks + threads - 1) / threads };
+        std::size_t rowsPerThread{ blocksPerThread * blockSize };
+
+        std::vector<std::thread> workers{};
+        for (std::size_t first{ rowsPerThread }; first < rows; first += rowsPerThread)
+            workers.emplace_back(evaluateRows, std::cref(program), columns, first, std::min(rows, first + rowsPerThread), results);
+
+        evaluateRows(program, columns, 0, std::min(rows, rowsPerThread), results);
+
+        for (std::thread& worker : workers)
+            worker.join();
+    }
+
+    bool compile(std::string_view expression, Program& program, CompileError& error, bool optimize)
+    {
+        Arena& arena{ scratchArena() };
+
+        bool compiled{ false };
+        {
+            Compiler compiler{ expression, program, error, optimize, arena };
+            compiled = compiler.run();
+        }
+
+        arena.reset();
+        return compiled;
+    }
+}
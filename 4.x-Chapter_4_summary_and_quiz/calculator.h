@@ -0,0 +1,199 @@
+#ifndef CALCULATOR_H
+#define CALCULATOR_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// The calculator from question 2, grown up: an expression such as "3 * (x + 2) / sqrt(y)" is parsed once into a compact register bytecode,
+// which can then be evaluated for as many rows of variable values as needed, without parsing or allocating again.
+// Supported: numbers (3, 2.5, 1e-3), variables, + - * /, unary minus, parentheses, and the functions listed in functions[] below.
+namespace calculator
+{
+    enum class OpCode : std::uint8_t
+    {
+        add,
+        subtract,
+        multiply,
+        divide,
+        negate,
+        squareRoot,
+        absolute,
+        exponential,
+        logarithm,
+        sine,
+        cosine,
+        tangent,
+        floor,
+        ceil,
+        power,
+        minimum,
+        maximum,
+        halt,
+    };
+
+    struct Function
+    {
+        std::string_view name;
+        OpCode op;
+        int arity;
+    };
+
+    inline constexpr Function functions[]{
+        { "sqrt", OpCode::squareRoot, 1 },
+        { "abs", OpCode::absolute, 1 },
+        { "exp", OpCode::exponential, 1 },
+        { "log", OpCode::logarithm, 1 },
+        { "sin", OpCode::sine, 1 },
+        { "cos", OpCode::cosine, 1 },
+        { "tan", OpCode::tangent, 1 },
+        { "floor", OpCode::floor, 1 },
+        { "ceil", OpCode::ceil, 1 },
+        { "pow", OpCode::power, 2 },
+        { "min", OpCode::minimum, 2 },
+        { "max", OpCode::maximum, 2 },
+    };
+
+    // min and max are written as the comparisons minpd/maxpd perform, so a row gives the same answer whether it is evaluated alone or in a block.
+    // (If either value is NaN, the result is left.)
+    constexpr double minimum(double left, double right)
+    {
+        return right < left ? right : left;
+    }
+
+    constexpr double maximum(double left, double right)
+    {
+        return right > left ? right : left;
+    }
+
+    // What one instruction computes. Every way of evaluating an expression (one row, a block, or at compile time) goes through this, so they all agree.
+    constexpr double applyOperation(OpCode op, double left, double right)
+    {
+        switch (op)
+        {
+        case OpCode::add: return left + right;
+        case OpCode::subtract: return left - right;
+        case OpCode::multiply: return left * right;
+        case OpCode::divide: return left / right;
+        case OpCode::negate: return -left;
+        case OpCode::squareRoot: return std::sqrt(left);
+        case OpCode::absolute: return std::fabs(left);
+        case OpCode::exponential: return std::exp(left);
+        case OpCode::logarithm: return std::log(left);
+        case OpCode::sine: return std::sin(left);
+        case OpCode::cosine: return std::cos(left);
+        case OpCode::tangent: return std::tan(left);
+        case OpCode::floor: return std::floor(left);
+        case OpCode::ceil: return std::ceil(left);
+        case OpCode::power: return std::pow(left, right);
+        case OpCode::minimum: return minimum(left, right);
+        case OpCode::maximum: return maximum(left, right);
+        case OpCode::halt: break;
+        }
+
+        return 0.0;
+    }
+
+    // One instruction: registers[destination] = op(registers[left], registers[right]). Unary operations ignore right.
+    struct Instruction
+    {
+        OpCode op{ OpCode::halt };
+        std::uint16_t destination{};
+        std::uint16_t left{};
+        std::uint16_t right{};
+    };
+
+    // A compiled expression.
+    // Registers are laid out as [constants][variables][intermediate results]. The constants are filled in once, when the program is compiled.
+    class Program
+    {
+    public:
+        // Variables in the order they first appear in the expression. evaluate() takes their values in this order.
+        const std::vector<std::string>& variables() const { return m_variables; }
+
+        // Returns the position of name in variables(), or -1.
+        int variableIndex(std::string_view name) const;
+
+        const std::vector<Instruction>& instructions() const { return m_instructions; }
+
+        // How many nodes of the parsed expression the optimizer folded away or merged with an identical one.
+        std::size_t nodesRemoved() const { return m_nodesRemoved; }
+
+        // The starting contents of the registers: the constants filled in, everything else 0.
+        const std::vector<double>& initialRegisters() const { return m_initialRegisters; }
+
+        // True if other computes exactly what this program does, from values given in the same order (variable names aside).
+        bool hasSameCode(const Program& other) const;
+
+        // Evaluates the expression for one row. registers is scratch space that must start as a copy of initialRegisters(); it can then be reused for every row.
+        double evaluate(const double* values, double* registers) const;
+
+    private:
+        friend class Compiler;
+        friend class BlockEvaluator;
+
+        std::vector<std::string> m_variables{};
+        std::vector<Instruction> m_instructions{};
+        std::vector<double> m_initialRegisters{};
+        std::uint16_t m_firstVariable{};
+        std::uint16_t m_result{};
+        std::size_t m_nodesRemoved{ 0 };
+    };
+
+    // Owns the scratch registers, so evaluating a row allocates nothing. Use one Evaluator per thread.
+    class Evaluator
+    {
+    public:
+        explicit Evaluator(const Program& program);
+
+        double evaluate(const double* values) { return m_program->evaluate(values, m_registers.data()); }
+
+    private:
+        const Program* m_program{};
+        std::vector<double> m_registers{};
+    };
+
+    // How many rows BlockEvaluator works on at once: enough for every operator to run as whole SIMD vectors, few enough that all the registers stay in the L1/L2 cache.
+    constexpr std::size_t blockSize{ 256 };
+
+    // Evaluates a Program a block of rows at a time. Each instruction runs over the whole block before the next one starts, so the interpreter's
+    // dispatch is paid once per block instead of once per row, and every operator is a simple loop the compiler turns into SIMD code.
+    // Use one BlockEvaluator per thread.
+    class BlockEvaluator
+    {
+    public:
+        explicit BlockEvaluator(const Program& program);
+
+        // columns[v] points at count values of variable v (count <= blockSize). The count results are written to results.
+        void evaluate(const double* const* columns, std::size_t count, double* results);
+
+    private:
+        const Program* m_program{};
+        std::vector<double> m_registers{};       // One block per register. Constant blocks are filled in once.
+        std::vector<const double*> m_sources{};  // Where each register's block is read from. Variables are read straight from the columns.
+        std::vector<double> m_partial{};         // A short last block is copied here and padded, so the kernels only ever see whole blocks.
+    };
+
+    // Evaluates program for rows rows, spreading whole blocks over threads cores (0 means all of them).
+    // columns[v] holds the rows values of variable v; results must have room for rows values.
+    void evaluateColumns(const Program& program, const double* const* columns, std::size_t rows, double* results, unsigned threads = 0);
+
+    // How deeply parentheses, function arguments and signs may nest. Every level costs the recursive parsers some stack,
+    // so past this an expression is rejected ("Expression is nested too deeply") instead of overflowing it.
+    constexpr std::size_t maxNesting{ 1000 };
+
+    struct CompileError
+    {
+        std::string message{};
+        std::size_t position{}; // Offset into the expression where the problem was found.
+    };
+
+    // Parses and compiles expression. Returns false (and describes the problem in error) if the expression is not valid.
+    // With optimize, constant subexpressions are folded and repeated ones computed once (see Program::nodesRemoved()); the results are the same either way.
+    bool compile(std::string_view expression, Program& program, CompileError& error, bool optimize = true);
+}
+
+#endif
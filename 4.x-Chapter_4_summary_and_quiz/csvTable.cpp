@@ -0,0 +1,191 @@
+#include "csvTable.h"
+#include "inputReader.h"
+#include "mappedInput.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+const std::vector<double>* CsvTable::column(std::string_view name) const
+{
+    for (std::size_t i{ 0 }; i < names.size(); ++i)
+    {
+        if (names[i] == name)
+            return &columns[i];
+    }
+
+    return nullptr;
+}
+
+namespace
+{
+    constexpr std::size_t chunkSize{ 8 << 20 };
+
+    struct ChunkColumns
+    {
+        std::vector<std::vector<double>> columns{};
+        std::size_t rows{ 0 };
+        bool valid{ true };
+    };
+
+    bool isSpace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    const char* skipSpaces(const char* current, const char* last)
+    {
+        while (current != last && isSpace(*current))
+            ++current;
+
+        return current;
+    }
+
+    // Returns the end of the line that starts at first (the '\n', or last).
+    const char* lineEnd(const char* first, const char* last)
+    {
+        const char* newline{ static_cast<const char*>(std::memchr(first, '\n', static_cast<std::size_t>(last - first))) };
+        return newline ? newline : last;
+    }
+
+    // Parses every line of chunk into one value per column. Stops (with valid = false) at the first line that does not fit; rows then says which one.
+    void parseChunk(const TextChunk& chunk, std::size_t columnCount, ChunkColumns& result)
+    {
+        result.columns.assign(columnCount, {});
+        for (std::vector<double>& column : result.columns)
+            column.reserve(static_cast<std::size_t>(chunk.last - chunk.first) / (columnCount * 4) + 1);
+
+        const char* line{ chunk.first };
+        while (line != chunk.last)
+        {
+            const char* end{ lineEnd(line, chunk.last) };
+            const char* current{ skipSpaces(line, end) };
+
+            if (current != end)
+            {
+                for (std::size_t c{ 0 }; c < columnCount; ++c)
+                {
+                    if (c > 0)
+                    {
+                        if (current == end || *current != ',')
+                        {
+                            result.valid = false;
+                            return;
+                        }
+
+                        current = skipSpaces(current + 1, end);
+                    }
+
+                    double value{};
+                    std::from_chars_result parsed{ parseFloatingPoint(current, end, value) };
+                    if (parsed.ec == std::errc::invalid_argument)
+                    {
+                        result.valid = false;
+                        return;
+                    }
+                    if (parsed.ec == std::errc::result_out_of_range)
+                        value = outOfRangeValue(current, parsed.ptr);
+
+                    result.columns[c].push_back(value);
+                    current = skipSpaces(parsed.ptr, end);
+                }
+
+                if (current != end)
+                {
+                    result.valid = false;
+                    return;
+                }
+
+                ++result.rows;
+            }
+
+            line = (end == chunk.last) ? end : end + 1;
+        }
+    }
+
+    void parseChunks(const std::vector<TextChunk>& chunks, std::size_t first, std::size_t step, std::size_t columnCount, std::vector<ChunkColumns>& results)
+    {
+        for (std::size_t i{ first }; i < chunks.size(); i += step)
+            parseChunk(chunks[i], columnCount, results[i]);
+    }
+}
+
+bool loadCsv(const char* path, CsvTable& table, unsigned threads)
+{
+    MappedFile file{ path };
+    if (!file.isOpen())
+    {
+        std::cerr << "Can not open " << path << ".\n";
+        return false;
+    }
+
+    table = CsvTable{};
+
+    const char* first{ file.data() };
+    const char* last{ file.data() + file.size() };
+
+    const char* headerEnd{ lineEnd(first, last) };
+    for (const char* name{ first }; name < headerEnd;)
+    {
+        const char* comma{ std::find(name, headerEnd, ',') };
+        const char* nameFirst{ skipSpaces(name, comma) };
+        const char* nameLast{ comma };
+        while (nameLast != nameFirst && isSpace(nameLast[-1]))
+            --nameLast;
+
+        table.names.emplace_back(nameFirst, nameLast);
+        name = comma + 1;
+    }
+
+    if (table.names.empty())
+    {
+        std::cerr << path << " has no header line naming its columns.\n";
+        return false;
+    }
+
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+
+    // Chunks are handed out round robin, and the main thread parses its share too.
+    const char* body{ headerEnd == last ? last : headerEnd + 1 };
+    std::vector<TextChunk> chunks{ splitAtLines(body, last, chunkSize) };
+    std::vector<ChunkColumns> results(chunks.size());
+    std::size_t columnCount{ table.names.size() };
+
+    std::vector<std::thread> workers{};
+    for (std::size_t i{ 1 }; i < threads && i < chunks.size(); ++i)
+        workers.emplace_back(parseChunks, std::cref(chunks), i, threads, columnCount, std::ref(results));
+
+    parseChunks(chunks, 0, threads, columnCount, results);
+
+    for (std::thread& worker : workers)
+        worker.join();
+
+    for (const ChunkColumns& result : results)
+    {
+        table.rows += result.rows;
+        if (!result.valid)
+        {
+            std::cerr << "Row " << table.rows + 1 << " of " << path << ": expected " << columnCount << " comma-separated numbers.\n";
+            return false;
+        }
+    }
+
+    table.columns.resize(columnCount);
+    for (std::size_t c{ 0 }; c < columnCount; ++c)
+    {
+        std::vector<double>& column{ table.columns[c] };
+        column.reserve(table.rows);
+        for (const ChunkColumns& result : results)
+            column.insert(column.end(), result.columns[c].begin(), result.columns[c].end());
+    }
+
+    return true;
+}
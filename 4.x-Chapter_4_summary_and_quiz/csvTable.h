@@ -0,0 +1,25 @@
+#ifndef CSV_TABLE_H
+#define CSV_TABLE_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// A CSV file of numbers, loaded column by column: every column is one contiguous array of doubles, ready for BlockEvaluator.
+// The first line holds the column names, e.g. "x,y,z"; every other line holds one number per column.
+struct CsvTable
+{
+    std::vector<std::string> names{};
+    std::vector<std::vector<double>> columns{};
+    std::size_t rows{ 0 };
+
+    // Returns the column called name, or nullptr.
+    const std::vector<double>* column(std::string_view name) const;
+};
+
+// Memory-maps the file at path and parses it on threads cores (0 means all of them).
+// Returns false (after reporting on stderr) if the file can not be opened, or a line does not hold one number per column.
+bool loadCsv(const char* path, CsvTable& table, unsigned threads = 0);
+
+#endif
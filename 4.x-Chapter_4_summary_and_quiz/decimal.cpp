@@ -0,0 +1,168 @@
+#include "decimal.h"
+#include "outputWriter.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// Like calculator.cpp's block kernels: compiled once per instruction set, and the best one for this CPU is picked when the program loads.
+#if defined(__GNUC__) && defined(__x86_64__) && defined(__ELF__)
+#define DECIMAL_COLUMN_KERNEL __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define DECIMAL_COLUMN_KERNEL
+#endif
+
+namespace calculator
+{
+    namespace
+    {
+        constexpr std::int64_t powersOfTen[]{
+            1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000,
+            10000000000, 100000000000, 1000000000000, 10000000000000, 100000000000000, 1000000000000000,
+            10000000000000000, 100000000000000000, 1000000000000000000,
+        };
+    }
+
+    bool parseDecimal(std::string_view text, int scale, Rounding rounding, std::int64_t& raw)
+    {
+        const char* current{ text.data() };
+        const char* last{ text.data() + text.size() };
+
+        bool negative{ false };
+        if (current != last && (*current == '+' || *current == '-'))
+        {
+            negative = *current == '-';
+            ++current;
+        }
+
+        // The digits go into one unsigned count of 10^-scale; the negative end of the range is one further than the positive.
+        std::uint64_t limit{ negative ? std::uint64_t{ 1 } << 63 : (std::uint64_t{ 1 } << 63) - 1 };
+        std::uint64_t magnitude{ 0 };
+        bool hasDigits{ false };
+        bool tooBig{ false };
+
+        auto appendDigit{ [&](char c)
+        {
+            std::uint64_t digit{ static_cast<std::uint64_t>(c - '0') };
+            if (magnitude > (limit - digit) / 10)
+                tooBig = true;
+            else
+                magnitude = magnitude * 10 + digit;
+        } };
+
+        for (; current != last && *current >= '0' && *current <= '9'; ++current)
+        {
+            appendDigit(*current);
+            hasDigits = true;
+        }
+
+        int places{ 0 };
+        int firstDropped{ 0 }; // The first digit past scale places, and whether any after it is not zero.
+        bool restDropped{ false };
+        if (current != last && *current == '.')
+        {
+            for (++current; current != last && *current >= '0' && *current <= '9'; ++current)
+            {
+                hasDigits = true;
+                if (places < scale)
+                {
+                    appendDigit(*current);
+                    ++places;
+                }
+                else if (places++ == scale)
+                    firstDropped = *current - '0';
+                else if (*current != '0')
+                    restDropped = true;
+            }
+        }
+
+        if (!hasDigits || current != last)
+            return false;
+
+        for (; places < scale; ++places)
+            appendDigit('0');
+
+        // The dropped digits as the remainder of a division by 10 (with a sticky 1 for anything after the first), rounded like any other.
+        // Only the last digit's parity matters to the rounding, so it is done on that, to learn whether the magnitude goes up by one.
+        std::int64_t remainder{ firstDropped * 2 + (restDropped ? 1 : 0) };
+        std::int64_t parity{ static_cast<std::int64_t>(magnitude % 2) };
+        if (negative)
+        {
+            remainder = -remainder;
+            parity = -parity;
+        }
+
+        if (detail::roundQuotient<std::int64_t>(parity, remainder, 20, rounding) != parity)
+        {
+            if (magnitude == limit)
+                tooBig = true;
+            else
+                ++magnitude;
+        }
+
+        if (tooBig)
+            return false;
+
+        raw = static_cast<std::int64_t>(negative ? 0 - magnitude : magnitude);
+        return true;
+    }
+
+    char* formatDecimal(char* out, std::int64_t raw, int scale)
+    {
+        // Negating as unsigned also works for the smallest int64_t, which has no positive counterpart.
+        std::uint64_t magnitude{ static_cast<std::uint64_t>(raw) };
+        if (raw < 0)
+        {
+            *out++ = '-';
+            magnitude = 0 - magnitude;
+        }
+
+        std::uint64_t unit{ static_cast<std::uint64_t>(powersOfTen[scale]) };
+        out = formatInteger(out, static_cast<unsigned long long>(magnitude / unit));
+        if (scale == 0)
+            return out;
+
+        *out = '.';
+        std::uint64_t fraction{ magnitude % unit };
+        for (int i{ scale }; i > 0; --i)
+        {
+            out[i] = static_cast<char>('0' + fraction % 10);
+            fraction /= 10;
+        }
+
+        return out + scale + 1;
+    }
+
+    OutputWriter& writeDecimal(OutputWriter& out, std::int64_t raw, int scale)
+    {
+        char* first{ out.prepareWrite(maxDecimalLength) };
+        out.commitWrite(static_cast<std::size_t>(formatDecimal(first, raw, scale) - first));
+        return out;
+    }
+
+    DECIMAL_COLUMN_KERNEL
+    void addDecimalColumns(const std::int64_t* x, const std::int64_t* y, std::int64_t* out, std::size_t count)
+    {
+        for (std::size_t i{ 0 }; i < count; ++i)
+            out[i] = x[i] + y[i];
+    }
+
+    DECIMAL_COLUMN_KERNEL
+    void subtractDecimalColumns(const std::int64_t* x, const std::int64_t* y, std::int64_t* out, std::size_t count)
+    {
+        for (std::size_t i{ 0 }; i < count; ++i)
+            out[i] = x[i] - y[i];
+    }
+
+    // Integer addition is associative, so unlike a sum of doubles, the vectorized sum (several partial sums, added at the end) is exactly the same.
+    DECIMAL_COLUMN_KERNEL
+    std::int64_t sumDecimalColumn(const std::int64_t* x, std::size_t count)
+    {
+        // Unsigned, where wrapping around is defined, so the compiler may reorder freely. The total is the same whenever it fits.
+        std::uint64_t sum{ 0 };
+        for (std::size_t i{ 0 }; i < count; ++i)
+            sum += static_cast<std::uint64_t>(x[i]);
+
+        return static_cast<std::int64_t>(sum);
+    }
+}
@@ -0,0 +1,288 @@
+#ifndef DECIMAL_H
+#define DECIMAL_H
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+
+#ifndef __SIZEOF_INT128__
+#error "Decimal multiplies and divides in 128 bits, which needs GCC or Clang on a 64-bit target."
+#endif
+
+class OutputWriter;
+
+namespace calculator
+{
+    // Where multiply(), divide(), rescale() and parseDecimal() go with a result that falls between two values the type can hold.
+    enum class Rounding : std::uint8_t
+    {
+        halfEven,         // To the nearest, and a tie to the even one ("banker's rounding"), so that sums of rounded values do not drift.
+        halfAwayFromZero, // To the nearest, and a tie away from zero, as taught in school.
+        towardZero,       // Drop the extra digits, like integer division does.
+        down,             // Toward minus infinity.
+        up,               // Toward plus infinity.
+    };
+
+    namespace detail
+    {
+        constexpr std::int64_t powerOfTen(int exponent)
+        {
+            std::int64_t power{ 1 };
+            for (int i{ 0 }; i < exponent; ++i)
+                power *= 10;
+
+            return power;
+        }
+
+        // Moves the truncated quotient of a division to where rounding wants it, given the remainder's sign and size.
+        // Without branches: in a loop over a column, whether a value rounds up is as good as random, and a mispredicted branch costs more than the sum.
+        template <typename Integer>
+        constexpr Integer roundQuotient(Integer quotient, Integer remainder, Integer denominator, Rounding rounding)
+        {
+            bool negative{ (remainder < 0) != (denominator < 0) };
+            bool inexact{ remainder != 0 };
+
+            // The remainder's size against half the denominator's, without overflowing: |remainder| against |denominator| - |remainder|.
+            Integer size{ remainder < 0 ? -remainder : remainder };
+            Integer rest{ (denominator < 0 ? -denominator : denominator) - size };
+
+            bool awayFromZero{ false };
+            switch (rounding)
+            {
+            case Rounding::halfEven:
+                awayFromZero = (size > rest) | ((size == rest) & ((quotient & 1) != 0));
+                break;
+            case Rounding::halfAwayFromZero:
+                awayFromZero = (size >= rest) & inexact;
+                break;
+            case Rounding::towardZero:
+                break;
+            case Rounding::down:
+                awayFromZero = negative & inexact;
+                break;
+            case Rounding::up:
+                awayFromZero = !negative & inexact;
+                break;
+            }
+
+            Integer step{ negative ? Integer{ -1 } : Integer{ 1 } };
+            return awayFromZero ? quotient + step : quotient;
+        }
+
+        // numerator / denominator, rounded. In 64 bits when the numerator fits, where a constant denominator becomes a multiplication.
+        constexpr std::int64_t divideRounded(__int128 numerator, std::int64_t denominator, Rounding rounding)
+        {
+            if (numerator >= std::numeric_limits<std::int64_t>::min() && numerator <= std::numeric_limits<std::int64_t>::max())
+            {
+                std::int64_t narrow{ static_cast<std::int64_t>(numerator) };
+                return roundQuotient<std::int64_t>(narrow / denominator, narrow % denominator, denominator, rounding);
+            }
+
+            __int128 wide{ denominator };
+            return static_cast<std::int64_t>(roundQuotient<__int128>(numerator / wide, numerator % wide, wide, rounding));
+        }
+    }
+
+    // A number with exactly Scale decimal places, kept as an integer count of 10^-Scale: Decimal<2> counts hundredths,
+    // so 6.35 is held as 635 and stays 6.35, where a float holds the nearest binary fraction, 6.34999990463...
+    // Adding and subtracting are integer additions, and exact. multiply() and divide() work out the exact result in 128 bits and round it
+    // once, the way the Rounding says. Like int, the value must fit: Decimal<2> reaches about 92 quadrillion.
+    template <int Scale>
+    class Decimal
+    {
+        static_assert(Scale >= 0 && Scale <= 18, "An int64_t holds at most 18 decimal places");
+
+    public:
+        static constexpr int scale{ Scale };
+
+        // The raw value of 1: 100 for Decimal<2>.
+        static constexpr std::int64_t unit{ detail::powerOfTen(Scale) };
+
+        constexpr Decimal() = default;
+
+        // The whole number: Decimal<2>{ 3 } is 3.00.
+        constexpr explicit Decimal(std::int64_t whole)
+            : m_raw{ whole * unit }
+        {
+        }
+
+        // The number raw * 10^-Scale: Decimal<2>::fromRaw(635) is 6.35.
+        static constexpr Decimal fromRaw(std::int64_t raw)
+        {
+            Decimal value{};
+            value.m_raw = raw;
+            return value;
+        }
+
+        constexpr std::int64_t raw() const { return m_raw; }
+
+        // The nearest double, for code that works in floating point.
+        constexpr double toDouble() const { return static_cast<double>(m_raw) / static_cast<double>(unit); }
+
+        constexpr Decimal& operator+=(Decimal other)
+        {
+            m_raw += other.m_raw;
+            return *this;
+        }
+
+        constexpr Decimal& operator-=(Decimal other)
+        {
+            m_raw -= other.m_raw;
+            return *this;
+        }
+
+        friend constexpr Decimal operator+(Decimal x, Decimal y) { return x += y; }
+        friend constexpr Decimal operator-(Decimal x, Decimal y) { return x -= y; }
+        friend constexpr Decimal operator-(Decimal x) { return fromRaw(-x.m_raw); }
+
+        // By a whole number (a count of items, say), which is exact.
+        friend constexpr Decimal operator*(Decimal x, std::int64_t factor) { return fromRaw(x.m_raw * factor); }
+        friend constexpr Decimal operator*(std::int64_t factor, Decimal x) { return fromRaw(x.m_raw * factor); }
+
+        friend constexpr bool operator==(Decimal x, Decimal y) = default;
+        friend constexpr std::strong_ordering operator<=>(Decimal x, Decimal y) = default;
+
+    private:
+        std::int64_t m_raw{ 0 };
+    };
+
+    // x * y and x / y (y not zero), rounded to Scale places.
+    template <int Scale>
+    constexpr Decimal<Scale> multiply(Decimal<Scale> x, Decimal<Scale> y, Rounding rounding = Rounding::halfEven)
+    {
+        return Decimal<Scale>::fromRaw(detail::divideRounded(static_cast<__int128>(x.raw()) * y.raw(), Decimal<Scale>::unit, rounding));
+    }
+
+    template <int Scale>
+    constexpr Decimal<Scale> divide(Decimal<Scale> x, Decimal<Scale> y, Rounding rounding = Rounding::halfEven)
+    {
+        __int128 numerator{ static_cast<__int128>(x.raw()) * Decimal<Scale>::unit };
+        __int128 denominator{ y.raw() };
+        return Decimal<Scale>::fromRaw(static_cast<std::int64_t>(detail::roundQuotient<__int128>(numerator / denominator, numerator % denominator, denominator, rounding)));
+    }
+
+    template <int Scale>
+    constexpr Decimal<Scale> operator*(Decimal<Scale> x, Decimal<Scale> y)
+    {
+        return multiply(x, y);
+    }
+
+    template <int Scale>
+    constexpr Decimal<Scale> operator/(Decimal<Scale> x, Decimal<Scale> y)
+    {
+        return divide(x, y);
+    }
+
+    // The same number with To places instead of From: exact when there are more places, rounded when there are fewer.
+    template <int To, int From>
+    constexpr Decimal<To> rescale(Decimal<From> x, Rounding rounding = Rounding::halfEven)
+    {
+        if constexpr (To >= From)
+            return Decimal<To>::fromRaw(x.raw() * detail::powerOfTen(To - From));
+        else
+            return Decimal<To>::fromRaw(detail::divideRounded(x.raw(), detail::powerOfTen(From - To), rounding));
+    }
+
+    // Reads an optional sign, digits, and optionally a '.' and more digits ("12", "-0.5", "3.", ".25"), and nothing else.
+    // Digits beyond scale places are rounded away. Returns false (leaving raw alone) for anything else, or a number too big for an int64_t.
+    bool parseDecimal(std::string_view text, int scale, Rounding rounding, std::int64_t& raw);
+
+    template <int Scale>
+    bool parseDecimal(std::string_view text, Decimal<Scale>& value, Rounding rounding = Rounding::halfEven)
+    {
+        std::int64_t raw{};
+        if (!parseDecimal(text, Scale, rounding, raw))
+            return false;
+
+        value = Decimal<Scale>::fromRaw(raw);
+        return true;
+    }
+
+    // The most characters formatDecimal() writes: "-9223372036854775808" and the '.', or "-0." and 18 places.
+    constexpr std::size_t maxDecimalLength{ 21 };
+
+    // Writes raw * 10^-scale with exactly scale places ("-0.05", "12.00") and returns the end. No locale, no rounding: the digits are all there is.
+    char* formatDecimal(char* out, std::int64_t raw, int scale);
+
+    template <int Scale>
+    char* formatDecimal(char* out, Decimal<Scale> value)
+    {
+        return formatDecimal(out, value.raw(), Scale);
+    }
+
+    OutputWriter& writeDecimal(OutputWriter& out, std::int64_t raw, int scale);
+
+    template <int Scale>
+    OutputWriter& operator<<(OutputWriter& out, Decimal<Scale> value)
+    {
+        return writeDecimal(out, value.raw(), Scale);
+    }
+
+    // Column kernels, for whole columns of amounts: plain loops over the raw integers, compiled for the widest SIMD the CPU has.
+    void addDecimalColumns(const std::int64_t* x, const std::int64_t* y, std::int64_t* out, std::size_t count);
+    void subtractDecimalColumns(const std::int64_t* x, const std::int64_t* y, std::int64_t* out, std::size_t count);
+    std::int64_t sumDecimalColumn(const std::int64_t* x, std::size_t count);
+
+    // out[i] = x[i] + y[i]. out may be x or y.
+    template <int Scale>
+    void addColumns(const Decimal<Scale>* x, const Decimal<Scale>* y, Decimal<Scale>* out, std::size_t count)
+    {
+        // A Decimal is its raw integer and nothing else, so an array of them is an array of int64_t.
+        static_assert(sizeof(Decimal<Scale>) == sizeof(std::int64_t));
+        addDecimalColumns(reinterpret_cast<const std::int64_t*>(x), reinterpret_cast<const std::int64_t*>(y), reinterpret_cast<std::int64_t*>(out), count);
+    }
+
+    // out[i] = x[i] - y[i]. out may be x or y.
+    template <int Scale>
+    void subtractColumns(const Decimal<Scale>* x, const Decimal<Scale>* y, Decimal<Scale>* out, std::size_t count)
+    {
+        subtractDecimalColumns(reinterpret_cast<const std::int64_t*>(x), reinterpret_cast<const std::int64_t*>(y), reinterpret_cast<std::int64_t*>(out), count);
+    }
+
+    // The exact total of x[0..count).
+    template <int Scale>
+    Decimal<Scale> sumColumn(const Decimal<Scale>* x, std::size_t count)
+    {
+        return Decimal<Scale>::fromRaw(sumDecimalColumn(reinterpret_cast<const std::int64_t*>(x), count));
+    }
+
+    namespace detail
+    {
+        template <int Scale, Rounding rounding>
+        void multiplyColumn(const Decimal<Scale>* x, Decimal<Scale> factor, Decimal<Scale>* out, std::size_t count)
+        {
+            for (std::size_t i{ 0 }; i < count; ++i)
+                out[i] = multiply(x[i], factor, rounding);
+        }
+    }
+
+    // out[i] = multiply(x[i], factor, rounding), e.g. prices times a tax rate. Here in the header, with a loop per rounding,
+    // so that the division by unit is by a constant (which the compiler turns into a multiplication) and the rounding has no switch left in it.
+    // (There is no 64-bit high multiply in SIMD before AVX-512, so this one stays scalar.)
+    template <int Scale>
+    void multiplyColumn(const Decimal<Scale>* x, Decimal<Scale> factor, Decimal<Scale>* out, std::size_t count, Rounding rounding = Rounding::halfEven)
+    {
+        switch (rounding)
+        {
+        case Rounding::halfEven:
+            detail::multiplyColumn<Scale, Rounding::halfEven>(x, factor, out, count);
+            break;
+        case Rounding::halfAwayFromZero:
+            detail::multiplyColumn<Scale, Rounding::halfAwayFromZero>(x, factor, out, count);
+            break;
+        case Rounding::towardZero:
+            detail::multiplyColumn<Scale, Rounding::towardZero>(x, factor, out, count);
+            break;
+        case Rounding::down:
+            detail::multiplyColumn<Scale, Rounding::down>(x, factor, out, count);
+            break;
+        case Rounding::up:
+            detail::multiplyColumn<Scale, Rounding::up>(x, factor, out, count);
+            break;
+        }
+    }
+}
+
+#endif
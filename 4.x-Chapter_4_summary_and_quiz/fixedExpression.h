@@ -0,0 +1,404 @@
+#ifndef FIXED_EXPRESSION_H
+#define FIXED_EXPRESSION_H
+
+#include "calculator.h"
+#include "identifiers.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// The calculator again, but for expressions that are known when the program is compiled:
+//     static_assert(calculator::calculate<"(1 + 2) * 3 - 4 / 2">() == 7.0);
+//     double area{ calculator::calculate<"pi * r * r">(3.14159, radius) };
+// The compiler parses the expression (a mistake in it is a compile error), and turns it into plain code for exactly that expression,
+// so the program carries no parser and no bytecode for it. With only constants in it, the whole expression becomes one number.
+// Same grammar, functions and results as calculator::compile(); variables take their values in the order they first appear.
+// Needs C++20. Working out sqrt, exp, sin, ... at compile time relies on GCC treating the <cmath> functions as constant expressions;
+// with other compilers, expressions that use them still compile to specialized code but can not be used in a static_assert.
+namespace calculator
+{
+    // A string literal that can be passed as a template argument.
+    template <std::size_t N>
+    struct FixedString
+    {
+        char text[N]{};
+
+        constexpr FixedString(const char (&string)[N])
+        {
+            for (std::size_t i{ 0 }; i < N; ++i)
+                text[i] = string[i];
+        }
+
+        constexpr std::string_view view() const { return { text, N - 1 }; }
+    };
+
+    enum class FixedNodeKind : std::uint8_t
+    {
+        constant,
+        variable,
+        operation,
+    };
+
+    struct FixedNode
+    {
+        FixedNodeKind kind{ FixedNodeKind::constant };
+        OpCode op{ OpCode::halt };
+        double value{};
+        std::size_t variable{};
+        std::size_t left{};
+        std::size_t right{};
+    };
+
+    // A parsed expression. Like calculator.cpp's tree, children come before their parents.
+    // Every node takes at least one character of the expression, so Capacity (its length plus one) is always enough.
+    template <std::size_t Capacity>
+    struct FixedExpression
+    {
+        FixedNode nodes[Capacity]{};
+        std::size_t nodeCount{ 0 };
+        std::size_t root{ 0 };
+        std::size_t variableCount{ 0 };
+        std::size_t variableStart[Capacity]{}; // Where each variable's name is in the expression.
+        std::size_t variableLength[Capacity]{};
+    };
+
+    namespace detail
+    {
+        // Deliberately not constexpr: reaching it while parsing at compile time stops the compile, and the message shows up in the error trace.
+        inline void expressionError(const char*)
+        {
+        }
+
+        constexpr bool isDigit(char c)
+        {
+            return c >= '0' && c <= '9';
+        }
+
+        constexpr bool isIdentifierStart(char c)
+        {
+            return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+        }
+
+        constexpr int operandCount(OpCode op)
+        {
+            switch (op)
+            {
+            case OpCode::add:
+            case OpCode::subtract:
+            case OpCode::multiply:
+            case OpCode::divide:
+            case OpCode::power:
+            case OpCode::minimum:
+            case OpCode::maximum:
+                return 2;
+            default:
+                return 1;
+            }
+        }
+
+        // The same grammar as the Compiler in calculator.cpp, in a form the compiler can run.
+        template <std::size_t Capacity>
+        class FixedParser
+        {
+        public:
+            constexpr explicit FixedParser(std::string_view text)
+                : m_text{ text }
+            {
+            }
+
+            constexpr FixedExpression<Capacity> parse()
+            {
+                m_result.root = parseExpression();
+
+                skipSpaces();
+                if (m_position != m_text.size())
+                    expressionError("Unexpected character");
+
+                return m_result;
+            }
+
+        private:
+            constexpr void skipSpaces()
+            {
+                while (m_position < m_text.size() && (m_text[m_position] == ' ' || m_text[m_position] == '\t'))
+                    ++m_position;
+            }
+
+            constexpr bool accept(char c)
+            {
+                skipSpaces();
+                if (m_position < m_text.size() && m_text[m_position] == c)
+                {
+                    ++m_position;
+                    return true;
+                }
+
+                return false;
+            }
+
+            constexpr void expect(char c, const char* message)
+            {
+                if (!accept(c))
+                    expressionError(message);
+            }
+
+            constexpr std::size_t addNode(const FixedNode& node)
+            {
+                m_result.nodes[m_result.nodeCount] = node;
+                return m_result.nodeCount++;
+            }
+
+            constexpr std::size_t addOperation(OpCode op, std::size_t left, std::size_t right)
+            {
+                FixedNode node{};
+                node.kind = FixedNodeKind::operation;
+                node.op = op;
+                node.left = left;
+                node.right = right;
+                return addNode(node);
+            }
+
+            constexpr std::size_t parseExpression()
+            {
+                std::size_t result{ parseTerm() };
+                while (true)
+                {
+                    if (accept('+'))
+                        result = addOperation(OpCode::add, result, parseTerm());
+                    else if (accept('-'))
+                        result = addOperation(OpCode::subtract, result, parseTerm());
+                    else
+                        return result;
+                }
+            }
+
+            constexpr std::size_t parseTerm()
+            {
+                std::size_t result{ parseUnary() };
+                while (true)
+                {
+                    if (accept('*'))
+                        result = addOperation(OpCode::multiply, result, parseUnary());
+                    else if (accept('/'))
+                        result = addOperation(OpCode::divide, result, parseUnary());
+                    else
+                        return result;
+                }
+            }
+
+            constexpr std::size_t parseUnary()
+            {
+                if (m_depth == maxNesting)
+                    expressionError("Expression is nested too deeply");
+
+                ++m_depth;
+                std::size_t result{ parseSigned() };
+                --m_depth;
+                return result;
+            }
+
+            constexpr std::size_t parseSigned()
+            {
+                if (accept('-'))
+                {
+                    std::size_t operand{ parseUnary() };
+                    return addOperation(OpCode::negate, operand, operand);
+                }
+
+                if (accept('+'))
+                    return parseUnary();
+
+                return parsePrimary();
+            }
+
+            constexpr std::size_t parsePrimary()
+            {
+                skipSpaces();
+                if (m_position == m_text.size())
+                    expressionError("Expected a number, a variable or '('");
+
+                char c{ m_text[m_position] };
+
+                if (c == '(')
+                {
+                    ++m_position;
+                    std::size_t result{ parseExpression() };
+                    expect(')', "Expected ')'");
+                    return result;
+                }
+
+                if (isDigit(c) || c == '.')
+                    return parseNumber();
+
+                if (isIdentifierStart(c))
+                    return parseIdentifier();
+
+                expressionError("Expected a number, a variable or '('");
+                return 0;
+            }
+
+            // Reads the digits as one whole number and scales it by a power of ten in a single multiplication or division.
+            // While both the digits (up to 2^53) and the power of ten (up to 10^22) are exact doubles, that one rounding gives
+            // the correctly rounded value, the same one std::from_chars finds at run time. Numbers outside that range are refused.
+            constexpr std::size_t parseNumber()
+            {
+                std::uint64_t digits{ 0 };
+                int exponent{ 0 };
+                bool anyDigits{ false };
+
+                auto readDigits{ [&](bool afterPoint)
+                {
+                    while (m_position < m_text.size() && isDigit(m_text[m_position]))
+                    {
+                        anyDigits = true;
+                        digits = digits * 10 + static_cast<std::uint64_t>(m_text[m_position] - '0');
+                        if (digits > (std::uint64_t{ 1 } << 53))
+                            expressionError("Number has too many digits to convert exactly at compile time");
+
+                        if (afterPoint)
+                            --exponent;
+                        ++m_position;
+                    }
+                } };
+
+                readDigits(false);
+                if (m_position < m_text.size() && m_text[m_position] == '.')
+                {
+                    ++m_position;
+                    readDigits(true);
+                }
+
+                if (!anyDigits)
+                    expressionError("Invalid number");
+
+                if (m_position < m_text.size() && (m_text[m_position] == 'e' || m_text[m_position] == 'E'))
+                {
+                    ++m_position;
+                    bool negative{ m_position < m_text.size() && m_text[m_position] == '-' };
+                    if (m_position < m_text.size() && (m_text[m_position] == '-' || m_text[m_position] == '+'))
+                        ++m_position;
+
+                    if (m_position == m_text.size() || !isDigit(m_text[m_position]))
+                        expressionError("Invalid number");
+
+                    int written{ 0 };
+                    while (m_position < m_text.size() && isDigit(m_text[m_position]))
+                    {
+                        written = written * 10 + (m_text[m_position] - '0');
+                        if (written > 1000)
+                            expressionError("Exponent is too large");
+                        ++m_position;
+                    }
+
+                    exponent += negative ? -written : written;
+                }
+
+                if (exponent < -22 || exponent > 22)
+                    expressionError("Number can not be converted exactly at compile time");
+
+                double power{ 1.0 };
+                for (int i{ 0 }; i < (exponent < 0 ? -exponent : exponent); ++i)
+                    power *= 10.0;
+
+                FixedNode node{};
+                node.kind = FixedNodeKind::constant;
+                node.value = exponent < 0 ? static_cast<double>(digits) / power : static_cast<double>(digits) * power;
+                return addNode(node);
+            }
+
+            constexpr std::size_t parseIdentifier()
+            {
+                std::size_t start{ m_position };
+                while (m_position < m_text.size() && (isIdentifierStart(m_text[m_position]) || isDigit(m_text[m_position])))
+                    ++m_position;
+
+                std::string_view name{ m_text.substr(start, m_position - start) };
+                Identifier identifier{ classifyIdentifier(name) };
+
+                if (identifier.kind == IdentifierKind::keyword)
+                    expressionError("A C++ keyword can not be used as a variable name");
+
+                if (const Function* function{ identifier.function })
+                {
+                    expect('(', "Expected '(' after a function name");
+
+                    std::size_t left{ parseExpression() };
+                    std::size_t right{ left };
+                    if (function->arity == 2)
+                    {
+                        expect(',', "Expected ','");
+                        right = parseExpression();
+                    }
+
+                    expect(')', "Expected ')'");
+                    return addOperation(function->op, left, right);
+                }
+
+                FixedNode node{};
+                node.kind = FixedNodeKind::variable;
+                node.variable = m_result.variableCount;
+                for (std::size_t v{ 0 }; v < m_result.variableCount; ++v)
+                {
+                    if (m_text.substr(m_result.variableStart[v], m_result.variableLength[v]) == name)
+                        node.variable = v;
+                }
+
+                if (node.variable == m_result.variableCount)
+                {
+                    m_result.variableStart[m_result.variableCount] = start;
+                    m_result.variableLength[m_result.variableCount] = name.size();
+                    ++m_result.variableCount;
+                }
+
+                return addNode(node);
+            }
+
+            std::string_view m_text{};
+            std::size_t m_position{ 0 };
+            std::size_t m_depth{ 0 };
+            FixedExpression<Capacity> m_result{};
+        };
+
+        template <const auto& expression, std::size_t index>
+        constexpr double evaluateNode(const double* values)
+        {
+            constexpr FixedNode node{ expression.nodes[index] };
+
+            if constexpr (node.kind == FixedNodeKind::constant)
+                return node.value;
+            else if constexpr (node.kind == FixedNodeKind::variable)
+                return values[node.variable];
+            else if constexpr (operandCount(node.op) == 1)
+                return applyOperation(node.op, evaluateNode<expression, node.left>(values), 0.0);
+            else
+                return applyOperation(node.op, evaluateNode<expression, node.left>(values), evaluateNode<expression, node.right>(values));
+        }
+    }
+
+    // Expression, parsed by the compiler.
+    template <FixedString Expression>
+    inline constexpr FixedExpression<sizeof(Expression.text)> fixedExpression{ detail::FixedParser<sizeof(Expression.text)>{ Expression.view() }.parse() };
+
+    // The names of Expression's variables, in the order calculate() takes their values.
+    template <FixedString Expression>
+    constexpr std::string_view variableName(std::size_t index)
+    {
+        constexpr const auto& expression{ fixedExpression<Expression> };
+        return Expression.view().substr(expression.variableStart[index], expression.variableLength[index]);
+    }
+
+    // Evaluates Expression with values for its variables. Usable in constant expressions (static_assert, constexpr variables) and at run time,
+    // where it compiles to straight-line code for just this expression.
+    template <FixedString Expression, typename... Values>
+    constexpr double calculate(Values... values)
+    {
+        constexpr const auto& expression{ fixedExpression<Expression> };
+        static_assert(sizeof...(Values) == expression.variableCount, "calculate() needs one value per variable in the expression");
+
+        const double valueArray[]{ static_cast<double>(values)..., 0.0 };
+        return detail::evaluateNode<expression, expression.root>(valueArray);
+    }
+}
+
+#endif
@@ -0,0 +1,152 @@
+#include "halfFloat.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HALF_FLOAT_HAS_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+// Like calculator.cpp's block kernels: compiled once per instruction set, and the best one for this CPU is picked when the program loads.
+#if defined(__GNUC__) && defined(__x86_64__) && defined(__ELF__)
+#define HALF_FLOAT_KERNEL __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define HALF_FLOAT_KERNEL
+#endif
+
+namespace calculator
+{
+    namespace
+    {
+        using ToFloat16Function = void (*)(const float*, Float16*, std::size_t);
+        using FromFloat16Function = void (*)(const Float16*, float*, std::size_t);
+
+        struct Float16Implementation
+        {
+            ToFloat16Function toFloat16;
+            FromFloat16Function toFloat;
+            const char* name;
+        };
+
+        void toFloat16Scalar(const float* in, Float16* out, std::size_t count)
+        {
+            for (std::size_t i{ 0 }; i < count; ++i)
+                out[i] = Float16{ in[i] };
+        }
+
+        void toFloatScalar(const Float16* in, float* out, std::size_t count)
+        {
+            for (std::size_t i{ 0 }; i < count; ++i)
+                out[i] = static_cast<float>(in[i]);
+        }
+
+#ifdef HALF_FLOAT_HAS_X86_KERNELS
+        // The rounding is given with the instruction, so the conversions do not depend on the MXCSR rounding mode.
+        constexpr int nearestEven{ _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC };
+
+        // F16C came with Ivy Bridge and Piledriver, after AVX and before AVX2.
+        __attribute__((target("avx,f16c")))
+        void toFloat16F16c(const float* in, Float16* out, std::size_t count)
+        {
+            std::size_t i{ 0 };
+            for (; i + 8 <= count; i += 8)
+            {
+                __m256 x{ _mm256_loadu_ps(in + i) };
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm256_cvtps_ph(x, nearestEven));
+            }
+
+            toFloat16Scalar(in + i, out + i, count - i);
+        }
+
+        __attribute__((target("avx,f16c")))
+        void toFloatF16c(const Float16* in, float* out, std::size_t count)
+        {
+            std::size_t i{ 0 };
+            for (; i + 8 <= count; i += 8)
+            {
+                __m128i x{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)) };
+                _mm256_storeu_ps(out + i, _mm256_cvtph_ps(x));
+            }
+
+            toFloatScalar(in + i, out + i, count - i);
+        }
+
+        // AVX-512F has its own 16-wide forms of the same instructions. (Masked 16-bit stores for the tail would need AVX-512BW as well.)
+        // The masked forms, with every lane selected, are the same instructions; the plain ones merge into an undefined vector, which GCC warns may be uninitialized.
+        __attribute__((target("avx512f")))
+        void toFloat16Avx512(const float* in, Float16* out, std::size_t count)
+        {
+            std::size_t i{ 0 };
+            for (; i + 16 <= count; i += 16)
+            {
+                __m512 x{ _mm512_loadu_ps(in + i) };
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm512_mask_cvtps_ph(_mm256_setzero_si256(), 0xFFFF, x, nearestEven));
+            }
+
+            toFloat16Scalar(in + i, out + i, count - i);
+        }
+
+        __attribute__((target("avx512f")))
+        void toFloatAvx512(const Float16* in, float* out, std::size_t count)
+        {
+            std::size_t i{ 0 };
+            for (; i + 16 <= count; i += 16)
+            {
+                __m256i x{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i)) };
+                _mm512_storeu_ps(out + i, _mm512_mask_cvtph_ps(_mm512_setzero_ps(), 0xFFFF, x));
+            }
+
+            toFloatScalar(in + i, out + i, count - i);
+        }
+#endif
+
+        Float16Implementation selectFloat16Implementation()
+        {
+#ifdef HALF_FLOAT_HAS_X86_KERNELS
+            __builtin_cpu_init();
+
+            if (__builtin_cpu_supports("avx512f"))
+                return { toFloat16Avx512, toFloatAvx512, "avx512" };
+            if (__builtin_cpu_supports("avx") && __builtin_cpu_supports("f16c"))
+                return { toFloat16F16c, toFloatF16c, "f16c" };
+#endif
+            return { toFloat16Scalar, toFloatScalar, "scalar" };
+        }
+
+        const Float16Implementation& float16Implementation()
+        {
+            static const Float16Implementation implementation{ selectFloat16Implementation() };
+            return implementation;
+        }
+    }
+
+    void toFloat16(const float* in, Float16* out, std::size_t count)
+    {
+        float16Implementation().toFloat16(in, out, count);
+    }
+
+    void toFloat(const Float16* in, float* out, std::size_t count)
+    {
+        float16Implementation().toFloat(in, out, count);
+    }
+
+    HALF_FLOAT_KERNEL
+    void toBFloat16(const float* in, BFloat16* out, std::size_t count)
+    {
+        for (std::size_t i{ 0 }; i < count; ++i)
+            out[i] = BFloat16{ in[i] };
+    }
+
+    HALF_FLOAT_KERNEL
+    void toFloat(const BFloat16* in, float* out, std::size_t count)
+    {
+        for (std::size_t i{ 0 }; i < count; ++i)
+            out[i] = static_cast<float>(in[i]);
+    }
+
+    const char* float16ImplementationName()
+    {
+        return float16Implementation().name;
+    }
+}
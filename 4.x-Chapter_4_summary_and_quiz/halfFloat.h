@@ -0,0 +1,142 @@
+#ifndef HALF_FLOAT_H
+#define HALF_FLOAT_H
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+// Two-byte floating point numbers, for storing long columns of measurements in half the memory of a float (lesson 4.3 lists the sizes
+// of the fundamental types; neither of these is one). They are for storage only: convert to float to compute, and back to store.
+//   Float16:  IEEE 754 binary16. 11 significant bits, about 3.3 decimal digits; up to 65504, and subnormals down to 6e-8.
+//   BFloat16: the top half of a float. The same range as a float, but only 8 significant bits, about 2.4 decimal digits.
+// Conversions from float round to the nearest, and a tie to the even one, like every float operation does (lesson 4.8);
+// a float too large for a Float16 becomes infinity. NaN stays NaN (quiet, with as much of its payload as fits), and the sign of zero is kept.
+namespace calculator
+{
+    class Float16
+    {
+    public:
+        Float16() = default;
+
+        constexpr explicit Float16(float value)
+            : m_bits{ fromFloat(value) }
+        {
+        }
+
+        constexpr explicit operator float() const
+        {
+            std::uint32_t sign{ static_cast<std::uint32_t>(m_bits & 0x8000) << 16 };
+            std::uint32_t exponent{ static_cast<std::uint32_t>(m_bits >> 10) & 0x1f };
+            std::uint32_t mantissa{ static_cast<std::uint32_t>(m_bits) & 0x3ff };
+
+            if (exponent == 0x1f) // Infinity, or NaN with its payload moved up and made quiet, as vcvtph2ps does.
+                return std::bit_cast<float>(sign | 0x7f800000 | (mantissa << 13) | (mantissa != 0 ? 0x00400000 : 0));
+            if (exponent == 0) // Zero or a subnormal, mantissa * 2^-24: exact in a float.
+                return std::bit_cast<float>(sign | std::bit_cast<std::uint32_t>(static_cast<float>(mantissa) * 0x1p-24f));
+
+            // From a bias of 15 to one of 127.
+            return std::bit_cast<float>(sign | ((exponent + 112) << 23) | (mantissa << 13));
+        }
+
+        constexpr std::uint16_t bits() const { return m_bits; }
+
+        static constexpr Float16 fromBits(std::uint16_t bits)
+        {
+            Float16 value{};
+            value.m_bits = bits;
+            return value;
+        }
+
+    private:
+        static constexpr std::uint16_t fromFloat(float value)
+        {
+            std::uint32_t bits{ std::bit_cast<std::uint32_t>(value) };
+            std::uint32_t sign{ (bits >> 16) & 0x8000 };
+            std::uint32_t magnitude{ bits & 0x7fffffff };
+
+            if (magnitude > 0x7f800000) // NaN: quiet, and the top of the payload, as vcvtps2ph does.
+                return static_cast<std::uint16_t>(sign | 0x7e00 | ((magnitude >> 13) & 0x3ff));
+
+            // 65520, halfway between the largest Float16 (65504) and the next power of two, already rounds (to even) past it.
+            if (magnitude >= 0x477ff000)
+                return static_cast<std::uint16_t>(sign | 0x7c00);
+
+            std::uint32_t result{};
+            std::uint32_t dropped{};
+            std::uint32_t half{};
+            if (magnitude >= 0x38800000)
+            {
+                // A normal Float16: from a bias of 127 to one of 15, dropping 13 bits of the mantissa. A carry out of the mantissa goes into the exponent, as it should.
+                result = (magnitude - 0x38000000) >> 13;
+                dropped = magnitude & 0x1fff;
+                half = 0x1000;
+            }
+            else
+            {
+                // Below 2^-14: a subnormal Float16, a number of 2^-24s. Below 2^-25, half of one, it rounds to zero.
+                std::uint32_t exponent{ magnitude >> 23 };
+                if (exponent < 102)
+                    return static_cast<std::uint16_t>(sign);
+
+                std::uint32_t mantissa{ (magnitude & 0x7fffff) | 0x800000 };
+                std::uint32_t shift{ 126 - exponent };
+                result = mantissa >> shift;
+                dropped = mantissa & ((std::uint32_t{ 1 } << shift) - 1);
+                half = std::uint32_t{ 1 } << (shift - 1);
+            }
+
+            result += (dropped > half) | ((dropped == half) & (result & 1));
+            return static_cast<std::uint16_t>(sign | result);
+        }
+
+        std::uint16_t m_bits{ 0 };
+    };
+
+    class BFloat16
+    {
+    public:
+        BFloat16() = default;
+
+        constexpr explicit BFloat16(float value)
+            : m_bits{ fromFloat(value) }
+        {
+        }
+
+        constexpr explicit operator float() const { return std::bit_cast<float>(static_cast<std::uint32_t>(m_bits) << 16); }
+
+        constexpr std::uint16_t bits() const { return m_bits; }
+
+        static constexpr BFloat16 fromBits(std::uint16_t bits)
+        {
+            BFloat16 value{};
+            value.m_bits = bits;
+            return value;
+        }
+
+    private:
+        static constexpr std::uint16_t fromFloat(float value)
+        {
+            std::uint32_t bits{ std::bit_cast<std::uint32_t>(value) };
+            if ((bits & 0x7fffffff) > 0x7f800000) // NaN: rounding could carry its payload into the exponent, so cut it and keep it quiet.
+                return static_cast<std::uint16_t>((bits >> 16) | 0x0040);
+
+            // Adding just under half of the dropped part, plus the lowest kept bit, rounds a tie to even. Past the largest BFloat16 it carries into infinity.
+            return static_cast<std::uint16_t>((bits + 0x7fff + ((bits >> 16) & 1)) >> 16);
+        }
+
+        std::uint16_t m_bits{ 0 };
+    };
+
+    // out[i] = in[i], converted, for i in [0, count). Float16 uses the CPU's own conversion instructions where it has them
+    // (F16C on 8 values at a time, or AVX-512 on 16), and otherwise the conversions above; the results are the same to the bit.
+    // BFloat16 needs no more than integer adds and shifts, which the compiler vectorizes for every instruction set.
+    void toFloat16(const float* in, Float16* out, std::size_t count);
+    void toFloat(const Float16* in, float* out, std::size_t count);
+    void toBFloat16(const float* in, BFloat16* out, std::size_t count);
+    void toFloat(const BFloat16* in, float* out, std::size_t count);
+
+    // Name of the implementation the Float16 array conversions dispatch to ("scalar", "f16c" or "avx512").
+    const char* float16ImplementationName();
+}
+
+#endif
@@ -0,0 +1,184 @@
+#ifndef IDENTIFIERS_H
+#define IDENTIFIERS_H
+
+#include "calculator.h"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+// Sorting the identifiers in an expression into built-in functions, reserved words and variable names.
+// The reserved words are the C++ keywords from lesson 1.7: a calculator cell called "int" or "return" would only confuse, so they are refused.
+// The lookup is a perfect hash table that the compiler builds: every word has a slot of its own, so classifying an identifier is
+// one hash, one table read and at most one string comparison, whatever the identifier is.
+namespace calculator
+{
+    enum class IdentifierKind : std::uint8_t
+    {
+        name,     // Free to use as a variable.
+        function, // One of functions[].
+        keyword,  // A C++ keyword.
+    };
+
+    inline constexpr std::string_view keywords[]{
+        "alignas", "alignof", "and", "and_eq", "asm", "auto",
+        "bitand", "bitor", "bool", "break",
+        "case", "catch", "char", "char8_t", "char16_t", "char32_t", "class", "compl", "concept", "const", "consteval", "constexpr", "constinit",
+        "const_cast", "continue", "co_await", "co_return", "co_yield",
+        "decltype", "default", "delete", "do", "double", "dynamic_cast",
+        "else", "enum", "explicit", "export", "extern",
+        "false", "float", "for", "friend",
+        "goto",
+        "if", "inline", "int",
+        "long",
+        "mutable",
+        "namespace", "new", "noexcept", "not", "not_eq", "nullptr",
+        "operator", "or", "or_eq",
+        "private", "protected", "public",
+        "register", "reinterpret_cast", "requires", "return",
+        "short", "signed", "sizeof", "static", "static_assert", "static_cast", "struct", "switch",
+        "template", "this", "thread_local", "throw", "true", "try", "typedef", "typeid", "typename",
+        "union", "unsigned", "using",
+        "virtual", "void", "volatile",
+        "wchar_t", "while",
+        "xor", "xor_eq",
+    };
+
+    namespace detail
+    {
+        // The words the table holds: the functions first, then the keywords.
+        constexpr std::size_t functionCount{ sizeof(functions) / sizeof(functions[0]) };
+        constexpr std::size_t wordCount{ functionCount + sizeof(keywords) / sizeof(keywords[0]) };
+
+        constexpr std::string_view word(std::size_t index)
+        {
+            return index < functionCount ? functions[index].name : keywords[index - functionCount];
+        }
+
+        // Four characters as a little-endian number, the same at compile time (where the table is built) and at run time (where it is searched).
+        constexpr std::uint32_t loadFour(const char* text)
+        {
+            if (std::endian::native == std::endian::little && !std::is_constant_evaluated())
+            {
+                std::uint32_t value{};
+                std::memcpy(&value, text, sizeof(value));
+                return value;
+            }
+
+            std::uint32_t value{ 0 };
+            for (int i{ 3 }; i >= 0; --i)
+                value = (value << 8) | static_cast<unsigned char>(text[i]);
+            return value;
+        }
+
+        // Sums up an identifier in 64 bits: its length and its first and last four characters (fewer for short words, which are read whole).
+        // Enough to tell all the words in the table apart; whatever else shares a key with one of them fails the final string comparison.
+        // On little-endian machines the two loads are single instructions; elsewhere the characters are put together one at a time.
+        constexpr std::uint64_t identifierKey(std::string_view text)
+        {
+            std::size_t length{ text.size() };
+            if (length >= 4)
+                return (std::uint64_t{ loadFour(text.data()) } << 32 | loadFour(text.data() + length - 4)) ^ length;
+
+            std::uint64_t key{ length };
+            for (char c : text)
+                key = (key << 8) | static_cast<unsigned char>(c);
+            return key;
+        }
+
+        constexpr int tableBits{ 10 };
+        constexpr std::size_t tableSize{ std::size_t{ 1 } << tableBits };
+
+        constexpr std::size_t slotOf(std::uint64_t key, std::uint64_t multiplier)
+        {
+            return static_cast<std::size_t>((key * multiplier) >> (64 - tableBits));
+        }
+
+        struct PerfectHashTable
+        {
+            std::uint64_t multiplier{ 0 };
+            std::uint8_t slots[tableSize]{}; // 0 for an empty slot, else the word's index plus one.
+        };
+
+        // Tries multipliers from a fixed pseudo-random sequence until one sends every word to a different slot.
+        // With about a hundred words in a thousand slots that takes a few hundred tries, all done by the compiler.
+        consteval PerfectHashTable buildPerfectHashTable()
+        {
+            static_assert(wordCount < 255, "A slot holds the word's index in one byte");
+
+            std::uint64_t state{ 0x9E3779B97F4A7C15 };
+            for (int attempt{ 0 }; attempt < 100000; ++attempt)
+            {
+                // splitmix64
+                state += 0x9E3779B97F4A7C15;
+                std::uint64_t multiplier{ state };
+                multiplier = (multiplier ^ (multiplier >> 30)) * 0xBF58476D1CE4E5B9;
+                multiplier = (multiplier ^ (multiplier >> 27)) * 0x94D049BB133111EB;
+                multiplier = (multiplier ^ (multiplier >> 31)) | 1;
+
+                PerfectHashTable table{};
+                table.multiplier = multiplier;
+
+                bool collision{ false };
+                for (std::size_t i{ 0 }; i < wordCount && !collision; ++i)
+                {
+                    std::uint8_t& slot{ table.slots[slotOf(identifierKey(word(i)), multiplier)] };
+                    collision = slot != 0;
+                    slot = static_cast<std::uint8_t>(i + 1);
+                }
+
+                if (!collision)
+                    return table;
+            }
+
+            return {}; // Not reached for the words above; an empty table would fail the static_assert below.
+        }
+
+        inline constexpr PerfectHashTable perfectHashTable{ buildPerfectHashTable() };
+        static_assert(perfectHashTable.multiplier != 0, "No perfect hash found for the function names and keywords");
+    }
+
+    struct Identifier
+    {
+        IdentifierKind kind{ IdentifierKind::name };
+        const Function* function{}; // For functions.
+    };
+
+    constexpr Identifier classifyIdentifier(std::string_view text)
+    {
+        using namespace detail;
+
+        std::uint8_t slot{ perfectHashTable.slots[slotOf(identifierKey(text), perfectHashTable.multiplier)] };
+        if (slot == 0 || word(slot - 1u) != text)
+            return {};
+
+        std::size_t index{ slot - 1u };
+        if (index < functionCount)
+            return { IdentifierKind::function, &functions[index] };
+
+        return { IdentifierKind::keyword, nullptr };
+    }
+
+    // Returns the built-in function called name, or nullptr.
+    constexpr const Function* findFunction(std::string_view name)
+    {
+        return classifyIdentifier(name).function;
+    }
+
+    // True if name is one of the built-in functions (sqrt, min, ...), which can not be used as a variable name.
+    constexpr bool isFunctionName(std::string_view name)
+    {
+        return classifyIdentifier(name).kind == IdentifierKind::function;
+    }
+
+    // True if name can not be used as a variable: it is a function or a C++ keyword.
+    constexpr bool isReservedName(std::string_view name)
+    {
+        return classifyIdentifier(name).kind != IdentifierKind::name;
+    }
+}
+
+#endif
@@ -0,0 +1,174 @@
+#include "integerCalculator.h"
+
+#include "bigInteger.h"
+#include "calculator.h"
+
+#include <cstddef>
+#include <string_view>
+
+namespace calculator
+{
+    namespace
+    {
+        bool isDigit(char c)
+        {
+            return c >= '0' && c <= '9';
+        }
+
+        // The same recursive descent as the Compiler in calculator.cpp, but working out each value as it goes instead of building a tree.
+        class IntegerEvaluator
+        {
+        public:
+            IntegerEvaluator(std::string_view text, CompileError& error)
+                : m_text{ text }, m_error{ error }
+            {
+            }
+
+            bool run(BigInteger& result)
+            {
+                if (!parseExpression(result))
+                    return false;
+
+                skipSpaces();
+                if (m_position != m_text.size())
+                    return fail("Unexpected character");
+
+                return true;
+            }
+
+        private:
+            bool fail(std::string_view message)
+            {
+                m_error.message = message;
+                m_error.position = m_position;
+                return false;
+            }
+
+            void skipSpaces()
+            {
+                while (m_position < m_text.size() && (m_text[m_position] == ' ' || m_text[m_position] == '\t'))
+                    ++m_position;
+            }
+
+            bool accept(char c)
+            {
+                skipSpaces();
+                if (m_position < m_text.size() && m_text[m_position] == c)
+                {
+                    ++m_position;
+                    return true;
+                }
+
+                return false;
+            }
+
+            bool parseExpression(BigInteger& result)
+            {
+                if (!parseTerm(result))
+                    return false;
+
+                while (true)
+                {
+                    bool subtract{};
+                    if (accept('+'))
+                        subtract = false;
+                    else if (accept('-'))
+                        subtract = true;
+                    else
+                        return true;
+
+                    BigInteger right{};
+                    if (!parseTerm(right))
+                        return false;
+
+                    if (subtract)
+                        result -= right;
+                    else
+                        result += right;
+                }
+            }
+
+            bool parseTerm(BigInteger& result)
+            {
+                if (!parseUnary(result))
+                    return false;
+
+                while (accept('*'))
+                {
+                    BigInteger right{};
+                    if (!parseUnary(right))
+                        return false;
+
+                    result *= right;
+                }
+
+                return true;
+            }
+
+            bool parseUnary(BigInteger& result)
+            {
+                if (m_depth == maxNesting)
+                    return fail("Expression is nested too deeply");
+
+                ++m_depth;
+                bool parsed{ parseSigned(result) };
+                --m_depth;
+                return parsed;
+            }
+
+            bool parseSigned(BigInteger& result)
+            {
+                if (accept('-'))
+                {
+                    if (!parseUnary(result))
+                        return false;
+
+                    result = -result;
+                    return true;
+                }
+
+                if (accept('+'))
+                    return parseUnary(result);
+
+                return parsePrimary(result);
+            }
+
+            bool parsePrimary(BigInteger& result)
+            {
+                skipSpaces();
+                if (m_position == m_text.size())
+                    return fail("Expected a whole number or '('");
+
+                if (m_text[m_position] == '(')
+                {
+                    ++m_position;
+                    if (!parseExpression(result))
+                        return false;
+
+                    return accept(')') || fail("Expected ')'");
+                }
+
+                std::size_t start{ m_position };
+                while (m_position < m_text.size() && isDigit(m_text[m_position]))
+                    ++m_position;
+
+                if (m_position == start)
+                    return fail("Expected a whole number or '('");
+
+                parseBigInteger(m_text.substr(start, m_position - start), result);
+                return true;
+            }
+
+            std::string_view m_text{};
+            std::size_t m_position{ 0 };
+            std::size_t m_depth{ 0 };
+            CompileError& m_error;
+        };
+    }
+
+    bool evaluateInteger(std::string_view expression, BigInteger& result, CompileError& error)
+    {
+        IntegerEvaluator evaluator{ expression, error };
+        return evaluator.run(result);
+    }
+}
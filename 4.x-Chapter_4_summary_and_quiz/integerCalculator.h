@@ -0,0 +1,17 @@
+#ifndef INTEGER_CALCULATOR_H
+#define INTEGER_CALCULATOR_H
+
+#include "bigInteger.h"
+#include "calculator.h"
+
+#include <string_view>
+
+// The calculator for whole numbers of any size: "123456789012345678901234567890 - (99999999999 + 1)" is worked out exactly,
+// where compile() would round every number to a double. Integers, '+', '-', '*' and parentheses, with the same spacing and error reporting as compile().
+namespace calculator
+{
+    // Returns false (and describes the problem in error) if the expression is not valid.
+    bool evaluateInteger(std::string_view expression, BigInteger& result, CompileError& error);
+}
+
+#endif
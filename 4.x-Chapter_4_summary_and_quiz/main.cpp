@@ -28,7 +28,8 @@
     d. The number of pages in a textbook.
     → int
     e. The length of a couch in feet, to 2 decimal places.
-    → float
+    → float (its 7 significant digits are plenty for a couch). For amounts that must stay exactly as written, such as money,
+      calculator::Decimal<2> in decimal.h keeps a whole number of hundredths instead, so 0.10 + 0.20 is exactly 0.30.
     f. How many times you've blinked since you were borne.
     → std::int32_t
     g. A user selecting an option from a menu by letter.
@@ -36,4 +37,319 @@
     h. The year someone was born.
     → std::int16_t
 */
-// Question 2: Write a calculator program.
\ No newline at end of file
+// Question 2: Write a calculator program.
+// → Type an expression with variables in it (e.g. "3 * x + y"), then a value for each variable.
+//   Or run main.out "3 * x + y" and give it one row of values per line on stdin (separated by spaces or commas), and it prints one result per line.
+//   The expression is compiled once (see calculator.h), so the rows cost no parsing beyond the numbers themselves.
+//   For big inputs, run main.out --csv data.csv "3 * x + y": the file's header names the columns, and the expression is evaluated a block of rows at a time on all cores.
+//   Add --cache <entries> before the expression to remember that many recent results, for inputs that repeat the same rows a lot.
+//   For what-if sessions, run main.out --repl: "price = 4" and "total = price * count" define cells, and any other line is evaluated against them.
+//   For whole numbers too big for a double to hold exactly, run main.out --big "123456789012345678901234567890 + 1" (see integerCalculator.h).
+#include "calculator.h"
+#include "csvTable.h"
+#include "decimal.h"
+#include "fixedExpression.h"
+#include "identifiers.h"
+#include "integerCalculator.h"
+#include "inputReader.h"
+#include "outputWriter.h"
+#include "resultCache.h"
+#include "worksheet.h"
+
+#include <charconv>
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+// Expressions that are known while compiling can be worked out by the compiler instead (see fixedExpression.h). It checks them here, too:
+static_assert(calculator::calculate<"(1 + 2) * 3 - 4 / 2">() == 7.0);
+static_assert(calculator::calculate<"2 * x + y">(3, 1) == 7.0);
+static_assert(calculator::calculate<"max(-x, x) / 4">(-10) == 2.5);
+
+// With doubles, 0.1 + 0.2 != 0.3. With hundredths counted exactly, it is:
+static_assert(calculator::Decimal<2>::fromRaw(10) + calculator::Decimal<2>::fromRaw(20) == calculator::Decimal<2>::fromRaw(30));
+static_assert(calculator::multiply(calculator::Decimal<2>::fromRaw(1999), calculator::Decimal<2>::fromRaw(5)) == calculator::Decimal<2>::fromRaw(100)); // 19.99 * 0.05 = 0.9995, rounded to 1.00
+
+void printCompileError(std::string_view expression, const calculator::CompileError& error)
+{
+    std::cerr << "Invalid expression: " << error.message << '\n';
+    std::cerr << "    " << expression << '\n';
+    std::cerr << "    " << std::string(error.position, ' ') << "^\n";
+}
+
+bool isSeparator(char c)
+{
+    return c == ' ' || c == '\t' || c == ',' || c == '\r';
+}
+
+// Reads the values of one row into values. Returns false if the line holds something other than numbers, or the wrong number of them.
+bool parseRow(std::string_view line, std::vector<double>& values)
+{
+    const char* current{ line.data() };
+    const char* last{ line.data() + line.size() };
+
+    for (double& value : values)
+    {
+        while (current != last && isSeparator(*current))
+            ++current;
+
+        std::from_chars_result result{ parseFloatingPoint(current, last, value) };
+        if (result.ec == std::errc::invalid_argument)
+            return false;
+        if (result.ec == std::errc::result_out_of_range)
+            value = outOfRangeValue(current, result.ptr);
+
+        current = result.ptr;
+    }
+
+    while (current != last && isSeparator(*current))
+        ++current;
+
+    return current == last;
+}
+
+// cacheEntries > 0 puts a ResultCache of that size in front of the evaluator, and reports how well it did on stderr.
+int evaluateRows(std::string_view expression, std::size_t cacheEntries)
+{
+    calculator::Program program{};
+    calculator::CompileError error{};
+    if (!calculator::compile(expression, program, error))
+    {
+        printCompileError(expression, error);
+        return 1;
+    }
+
+    std::ios_base::sync_with_stdio(false);
+
+    calculator::Evaluator evaluator{ program };
+    std::vector<double> values(program.variables().size());
+    OutputWriter& out{ standardOutput() };
+
+    std::unique_ptr<calculator::ResultCache> cache{};
+    std::unique_ptr<calculator::CachedEvaluator> cachedEvaluator{};
+    if (cacheEntries > 0)
+    {
+        cache = std::make_unique<calculator::ResultCache>(cacheEntries);
+        cachedEvaluator = std::make_unique<calculator::CachedEvaluator>(program, *cache);
+    }
+
+    std::string line{};
+    std::size_t row{ 0 };
+    while (std::getline(std::cin, line))
+    {
+        ++row;
+        if (!parseRow(line, values))
+        {
+            out.flush();
+            std::cerr << "Row " << row << ": expected " << values.size() << " numbers\n";
+            return 1;
+        }
+
+        out << (cachedEvaluator ? cachedEvaluator->evaluate(values.data()) : evaluator.evaluate(values.data())) << '\n';
+    }
+
+    if (cache)
+    {
+        out.flush();
+        calculator::ResultCache::Statistics statistics{ cache->statistics() };
+        std::cerr << "Cache: " << statistics.hits << " hits, " << statistics.misses << " misses, " << statistics.evictions << " evictions.\n";
+    }
+
+    return 0;
+}
+
+int evaluateCsv(const char* path, std::string_view expression)
+{
+    calculator::Program program{};
+    calculator::CompileError error{};
+    if (!calculator::compile(expression, program, error))
+    {
+        printCompileError(expression, error);
+        return 1;
+    }
+
+    CsvTable table{};
+    if (!loadCsv(path, table))
+        return 1;
+
+    std::vector<const double*> columns{};
+    for (const std::string& variable : program.variables())
+    {
+        const std::vector<double>* column{ table.column(variable) };
+        if (!column)
+        {
+            std::cerr << path << " has no column called " << variable << ".\n";
+            return 1;
+        }
+
+        columns.push_back(column->data());
+    }
+
+    std::vector<double> results(table.rows);
+    calculator::evaluateColumns(program, columns.data(), table.rows, results.data());
+
+    OutputWriter& out{ standardOutput() };
+    for (double result : results)
+        out << result << '\n';
+
+    return 0;
+}
+
+int evaluateInteractive()
+{
+    std::cout << "Enter an expression: ";
+
+    std::string expression{};
+    std::getline(std::cin, expression);
+
+    calculator::Program program{};
+    calculator::CompileError error{};
+    if (!calculator::compile(expression, program, error))
+    {
+        printCompileError(expression, error);
+        return 1;
+    }
+
+    std::vector<double> values(program.variables().size());
+    for (std::size_t i{ 0 }; i < values.size(); ++i)
+    {
+        std::cout << "Enter " << program.variables()[i] << ": ";
+        std::cin >> values[i];
+    }
+
+    calculator::Evaluator evaluator{ program };
+
+    OutputWriter& out{ standardOutput() };
+    out << expression << " = ";
+    out << evaluator.evaluate(values.data()) << '\n';
+
+    return 0;
+}
+
+// Splits "name = expression" into its two sides. Returns false if line is not a definition.
+bool splitDefinition(std::string_view line, std::string_view& name, std::string_view& expression)
+{
+    std::size_t equals{ line.find('=') };
+    if (equals == std::string_view::npos)
+        return false;
+
+    name = line.substr(0, equals);
+    expression = line.substr(equals + 1);
+
+    while (!name.empty() && (name.front() == ' ' || name.front() == '\t'))
+        name.remove_prefix(1);
+    while (!name.empty() && (name.back() == ' ' || name.back() == '\t'))
+        name.remove_suffix(1);
+
+    if (name.empty() || (name.front() >= '0' && name.front() <= '9'))
+        return false;
+
+    for (char c : name)
+    {
+        if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_'))
+            return false;
+    }
+
+    return true;
+}
+
+int runRepl()
+{
+    calculator::Worksheet sheet{};
+    std::string line{};
+
+    while (true)
+    {
+        std::cout << "> ";
+        if (!std::getline(std::cin, line))
+            break;
+
+        if (line.find_first_not_of(" \t\r") == std::string::npos)
+            continue;
+
+        std::string_view name{};
+        std::string_view expression{};
+        calculator::CompileError error{};
+        double result{};
+
+        if (splitDefinition(line, name, expression))
+        {
+            if (calculator::isReservedName(name))
+            {
+                std::cerr << name << " is " << (calculator::isFunctionName(name) ? "a function" : "a C++ keyword") << " and can not be used as a cell name.\n";
+                continue;
+            }
+
+            if (!sheet.define(name, expression, error))
+            {
+                error.position += static_cast<std::size_t>(expression.data() - line.data());
+                printCompileError(line, error);
+                continue;
+            }
+
+            result = sheet.value(name);
+            std::cout << name << " = ";
+        }
+        else if (!sheet.evaluate(line, result, error))
+        {
+            printCompileError(line, error);
+            continue;
+        }
+
+        char buffer[maxFloatingPointLength]{};
+        std::cout << std::string_view{ buffer, static_cast<std::size_t>(formatFloatingPoint(buffer, result) - buffer) } << '\n';
+    }
+
+    return 0;
+}
+
+// Works out an expression of whole numbers exactly, however many digits they have.
+int evaluateBig(std::string_view expression)
+{
+    BigInteger result{};
+    calculator::CompileError error{};
+    if (!calculator::evaluateInteger(expression, result, error))
+    {
+        printCompileError(expression, error);
+        return 1;
+    }
+
+    standardOutput() << result << '\n';
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc == 2 && std::string_view{ argv[1] } == "--repl")
+        return runRepl();
+
+    if (argc == 2)
+        return evaluateRows(argv[1], 0);
+
+    if (argc == 4 && std::string_view{ argv[1] } == "--cache")
+    {
+        std::string_view entries{ argv[2] };
+        std::size_t cacheEntries{};
+        std::from_chars_result parsed{ std::from_chars(entries.data(), entries.data() + entries.size(), cacheEntries) };
+        if (parsed.ec == std::errc{} && parsed.ptr == entries.data() + entries.size())
+            return evaluateRows(argv[3], cacheEntries);
+    }
+
+    if (argc == 3 && std::string_view{ argv[1] } == "--big")
+        return evaluateBig(argv[2]);
+
+    if (argc == 4 && std::string_view{ argv[1] } == "--csv")
+        return evaluateCsv(argv[2], argv[3]);
+
+    if (argc > 1)
+    {
+        std::cerr << "Usage: main.out [expression | --cache <entries> expression | --csv <file> expression | --big expression | --repl]\n";
+        return 1;
+    }
+
+    return evaluateInteractive();
+}
@@ -0,0 +1,273 @@
+#include "resultCache.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace calculator
+{
+    namespace
+    {
+        constexpr std::uint32_t none{ 0xFFFFFFFF };
+
+        std::uint64_t mix(std::uint64_t value)
+        {
+            value ^= value >> 33;
+            value *= 0xFF51AFD7ED558CCD;
+            value ^= value >> 33;
+            value *= 0xC4CEB9FE1A85EC53;
+            value ^= value >> 33;
+            return value;
+        }
+
+        std::uint64_t hashKey(std::uint32_t program, const double* values, std::size_t count)
+        {
+            std::uint64_t hash{ mix(program + 0x9E3779B97F4A7C15) };
+            for (std::size_t i{ 0 }; i < count; ++i)
+            {
+                std::uint64_t bits{};
+                std::memcpy(&bits, &values[i], sizeof(bits));
+                hash = mix(hash ^ bits);
+            }
+
+            return hash;
+        }
+    }
+
+    // One lock's worth of the cache: up to capacity entries in a doubly linked list from most to least recently used,
+    // found through an open-addressing table (linear probing) of entry indices. Nothing is allocated once the entries exist.
+    // Aligned to a cache line so that two shards' locks never share one.
+    struct alignas(64) ResultCache::Shard
+    {
+        struct Entry
+        {
+            std::uint64_t hash{};
+            std::uint32_t program{};
+            std::uint32_t previous{ none };
+            std::uint32_t next{ none };
+            double result{};
+            std::vector<double> values{};
+        };
+
+        std::mutex mutex{};
+        std::vector<Entry> entries{};
+        std::vector<std::uint32_t> table{}; // Entry index plus one; 0 for an empty slot.
+        std::size_t capacity{ 0 };
+        std::uint32_t newest{ none };
+        std::uint32_t oldest{ none };
+
+        std::uint64_t hits{ 0 };
+        std::uint64_t misses{ 0 };
+        std::uint64_t evictions{ 0 };
+
+        void setCapacity(std::size_t entryCount)
+        {
+            capacity = entryCount;
+            entries.reserve(entryCount);
+
+            std::size_t tableSize{ 4 };
+            while (tableSize < entryCount * 2)
+                tableSize *= 2;
+            table.assign(tableSize, 0);
+        }
+
+        std::size_t home(std::uint64_t hash) const
+        {
+            return static_cast<std::size_t>(hash) & (table.size() - 1);
+        }
+
+        bool matches(const Entry& entry, std::uint64_t hash, std::uint32_t program, const double* values, std::size_t count) const
+        {
+            return entry.hash == hash && entry.program == program && entry.values.size() == count
+                && std::memcmp(entry.values.data(), values, count * sizeof(double)) == 0;
+        }
+
+        std::uint32_t locate(std::uint64_t hash, std::uint32_t program, const double* values, std::size_t count) const
+        {
+            std::size_t mask{ table.size() - 1 };
+            for (std::size_t slot{ home(hash) }; table[slot] != 0; slot = (slot + 1) & mask)
+            {
+                std::uint32_t index{ table[slot] - 1 };
+                if (matches(entries[index], hash, program, values, count))
+                    return index;
+            }
+
+            return none;
+        }
+
+        void unlink(std::uint32_t index)
+        {
+            Entry& entry{ entries[index] };
+            (entry.previous == none ? newest : entries[entry.previous].next) = entry.next;
+            (entry.next == none ? oldest : entries[entry.next].previous) = entry.previous;
+        }
+
+        void pushNewest(std::uint32_t index)
+        {
+            Entry& entry{ entries[index] };
+            entry.previous = none;
+            entry.next = newest;
+            (newest == none ? oldest : entries[newest].previous) = index;
+            newest = index;
+        }
+
+        // Removes index from the table, shifting later entries of the same probe run back so that every entry stays reachable from its home slot.
+        void removeFromTable(std::uint32_t index)
+        {
+            std::size_t mask{ table.size() - 1 };
+            std::size_t slot{ home(entries[index].hash) };
+            while (table[slot] != index + 1)
+                slot = (slot + 1) & mask;
+
+            std::size_t next{ slot };
+            while (true)
+            {
+                next = (next + 1) & mask;
+                if (table[next] == 0)
+                    break;
+
+                // The entry at next may move into the hole unless its home slot lies (cyclically) after the hole, up to next.
+                std::size_t nextHome{ home(entries[table[next] - 1].hash) };
+                bool homeInBetween{ slot <= next ? (slot < nextHome && nextHome <= next) : (slot < nextHome || nextHome <= next) };
+                if (!homeInBetween)
+                {
+                    table[slot] = table[next];
+                    slot = next;
+                }
+            }
+
+            table[slot] = 0;
+        }
+
+        void addToTable(std::uint32_t index)
+        {
+            std::size_t mask{ table.size() - 1 };
+            std::size_t slot{ home(entries[index].hash) };
+            while (table[slot] != 0)
+                slot = (slot + 1) & mask;
+
+            table[slot] = index + 1;
+        }
+    };
+
+    ResultCache::ResultCache(std::size_t capacity, std::size_t shards)
+        : m_shards{ std::make_unique<Shard[]>(std::max<std::size_t>(shards, 1)) }, m_shardCount{ std::max<std::size_t>(shards, 1) }
+    {
+        std::size_t perShard{ std::max<std::size_t>((capacity + m_shardCount - 1) / m_shardCount, 1) };
+        for (std::size_t i{ 0 }; i < m_shardCount; ++i)
+            m_shards[i].setCapacity(perShard);
+    }
+
+    ResultCache::~ResultCache() = default;
+
+    ResultCache::Shard& ResultCache::shardFor(std::uint64_t hash)
+    {
+        // The table slot comes from the low bits of the hash, the shard from the high ones.
+        return m_shards[(hash >> 40) % m_shardCount];
+    }
+
+    std::uint32_t ResultCache::programId(const Program& program)
+    {
+        std::lock_guard<std::mutex> lock{ m_programsMutex };
+
+        for (std::size_t id{ 0 }; id < m_programs.size(); ++id)
+        {
+            if (m_programs[id].hasSameCode(program))
+                return static_cast<std::uint32_t>(id);
+        }
+
+        m_programs.push_back(program);
+        return static_cast<std::uint32_t>(m_programs.size() - 1);
+    }
+
+    bool ResultCache::find(std::uint32_t program, const double* values, std::size_t count, double& result)
+    {
+        std::uint64_t hash{ hashKey(program, values, count) };
+        Shard& shard{ shardFor(hash) };
+        std::lock_guard<std::mutex> lock{ shard.mutex };
+
+        std::uint32_t index{ shard.locate(hash, program, values, count) };
+        if (index == none)
+        {
+            ++shard.misses;
+            return false;
+        }
+
+        ++shard.hits;
+        shard.unlink(index);
+        shard.pushNewest(index);
+        result = shard.entries[index].result;
+        return true;
+    }
+
+    void ResultCache::insert(std::uint32_t program, const double* values, std::size_t count, double result)
+    {
+        std::uint64_t hash{ hashKey(program, values, count) };
+        Shard& shard{ shardFor(hash) };
+        std::lock_guard<std::mutex> lock{ shard.mutex };
+
+        // Another thread may have inserted the same row since our miss.
+        if (shard.locate(hash, program, values, count) != none)
+            return;
+
+        std::uint32_t index{};
+        if (shard.entries.size() < shard.capacity)
+        {
+            index = static_cast<std::uint32_t>(shard.entries.size());
+            shard.entries.emplace_back();
+        }
+        else
+        {
+            index = shard.oldest;
+            shard.removeFromTable(index);
+            shard.unlink(index);
+            ++shard.evictions;
+        }
+
+        Shard::Entry& entry{ shard.entries[index] };
+        entry.hash = hash;
+        entry.program = program;
+        entry.result = result;
+        entry.values.assign(values, values + count);
+
+        shard.addToTable(index);
+        shard.pushNewest(index);
+    }
+
+    ResultCache::Statistics ResultCache::statistics() const
+    {
+        Statistics total{};
+        for (std::size_t i{ 0 }; i < m_shardCount; ++i)
+        {
+            Shard& shard{ m_shards[i] };
+            std::lock_guard<std::mutex> lock{ shard.mutex };
+
+            total.hits += shard.hits;
+            total.misses += shard.misses;
+            total.evictions += shard.evictions;
+            total.size += shard.entries.size();
+        }
+
+        return total;
+    }
+
+    CachedEvaluator::CachedEvaluator(const Program& program, ResultCache& cache)
+        : m_evaluator{ program }, m_cache{ cache }, m_program{ cache.programId(program) }, m_variableCount{ program.variables().size() }
+    {
+    }
+
+    double CachedEvaluator::evaluate(const double* values)
+    {
+        double result{};
+        if (m_cache.find(m_program, values, m_variableCount, result))
+            return result;
+
+        result = m_evaluator.evaluate(values);
+        m_cache.insert(m_program, values, m_variableCount, result);
+        return result;
+    }
+}
@@ -0,0 +1,75 @@
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+
+#include "calculator.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace calculator
+{
+    // Remembers recent results by (program, input values), for workloads that evaluate the same rows over and over.
+    // Bounded: when full, the least recently used result makes room. The entries are spread over shards by hash, each with its own lock,
+    // so threads looking up different rows rarely wait for each other.
+    // A hit is only ever reported for exactly the same program and bit-for-bit the same values, so using the cache can not change a result.
+    class ResultCache
+    {
+    public:
+        struct Statistics
+        {
+            std::uint64_t hits{ 0 };
+            std::uint64_t misses{ 0 };
+            std::uint64_t evictions{ 0 };
+            std::size_t size{ 0 };
+        };
+
+        // Holds up to capacity results (rounded up to a multiple of shards).
+        explicit ResultCache(std::size_t capacity, std::size_t shards = 16);
+        ~ResultCache();
+
+        ResultCache(const ResultCache&) = delete;
+        ResultCache& operator=(const ResultCache&) = delete;
+
+        // Returns the id results of program are stored under. Programs with the same code get the same id, however they were compiled.
+        std::uint32_t programId(const Program& program);
+
+        // Looks up the result of program (by id) for values[0..count). Returns false if it is not cached.
+        bool find(std::uint32_t program, const double* values, std::size_t count, double& result);
+
+        void insert(std::uint32_t program, const double* values, std::size_t count, double result);
+
+        // Totals over all shards.
+        Statistics statistics() const;
+
+    private:
+        struct Shard;
+
+        Shard& shardFor(std::uint64_t hash);
+
+        std::unique_ptr<Shard[]> m_shards;
+        std::size_t m_shardCount{};
+
+        std::mutex m_programsMutex{};
+        std::vector<Program> m_programs{}; // Indexed by id.
+    };
+
+    // An Evaluator with a ResultCache in front of it. Use one per thread; they can all share one cache.
+    class CachedEvaluator
+    {
+    public:
+        CachedEvaluator(const Program& program, ResultCache& cache);
+
+        double evaluate(const double* values);
+
+    private:
+        Evaluator m_evaluator;
+        ResultCache& m_cache;
+        std::uint32_t m_program{};
+        std::size_t m_variableCount{};
+    };
+}
+
+#endif
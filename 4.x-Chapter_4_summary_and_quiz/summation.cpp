@@ -0,0 +1,521 @@
+#include "summation.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if !defined(__GNUC__) || !defined(__SIZEOF_INT128__)
+#error "summation.cpp uses GCC's vector extensions and 128-bit integers, which need GCC or Clang on a 64-bit target."
+#endif
+
+// Like calculator.cpp's block kernels: compiled once per instruction set, and the best one for this CPU is picked when the program loads.
+#if defined(__GNUC__) && defined(__x86_64__) && defined(__ELF__)
+#define SUMMATION_KERNEL __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define SUMMATION_KERNEL
+#endif
+
+namespace calculator
+{
+    namespace
+    {
+        // Every kernel keeps 16 partial sums side by side, as four vectors of four doubles: one AVX2 register each, or two SSE2 ones.
+        // It is the number of sums that is fixed, not the register width, so that every clone adds the same numbers in the same order,
+        // and they agree to the bit. (As plain arrays, sums that run the length of a loop were not vectorized at all; and vectors of
+        // eight doubles, which suit AVX-512, came out several times slower for AVX2.)
+        constexpr std::size_t vectorSize{ 4 };
+        constexpr std::size_t vectorCount{ 4 };
+        constexpr std::size_t lanes{ vectorSize * vectorCount };
+
+        using Vector = double __attribute__((vector_size(vectorSize * sizeof(double))));
+        using FloatVector = float __attribute__((vector_size(vectorSize * sizeof(float))));
+        using BitVector = std::int64_t __attribute__((vector_size(vectorSize * sizeof(std::int64_t))));
+
+        // The same vectors, in place in a column: at any address of an element, and reading and writing it like the elements would.
+        using VectorInPlace = double __attribute__((vector_size(vectorSize * sizeof(double)), aligned(alignof(double)), may_alias));
+        using FloatVectorInPlace = float __attribute__((vector_size(vectorSize * sizeof(float)), aligned(alignof(float)), may_alias));
+
+        struct Lanes
+        {
+            Vector vectors[vectorCount];
+        };
+
+        // The column is cut into chunks of this many values whatever the number of threads; each chunk gives one partial result.
+        constexpr std::size_t chunkSize{ std::size_t{ 1 } << 14 };
+
+        constexpr std::size_t pairwiseBlock{ 256 };
+
+        // The exact sum works on blocks small enough to stay in the L1 cache while it goes over them several times.
+        constexpr std::size_t exactBlock{ 1024 };
+
+        // The next lanes values, as doubles. (Through a reference rather than returned: vectors are returned differently by each clone.)
+        template <typename T>
+        void loadLanes(const T* values, Lanes& loaded)
+        {
+            for (std::size_t v{ 0 }; v < vectorCount; ++v)
+            {
+                if constexpr (std::is_same_v<T, double>)
+                    loaded.vectors[v] = *reinterpret_cast<const VectorInPlace*>(values + v * vectorSize);
+                else
+                    loaded.vectors[v] = __builtin_convertvector(*reinterpret_cast<const FloatVectorInPlace*>(values + v * vectorSize), Vector);
+            }
+        }
+
+        void storeLanes(const Lanes& stored, double* values)
+        {
+            for (std::size_t v{ 0 }; v < vectorCount; ++v)
+                *reinterpret_cast<VectorInPlace*>(values + v * vectorSize) = stored.vectors[v];
+        }
+
+        // Calls step(lanes) for values[0..count), lanes values at a time. The last few values are padded with zeros,
+        // which leave every kind of sum here as it was, so that they go into the lanes like all the others.
+        template <typename T, typename Step>
+        void forEachLanes(const T* values, std::size_t count, Step step)
+        {
+            Lanes loaded;
+
+            std::size_t i{ 0 };
+            for (; i + lanes <= count; i += lanes)
+            {
+                loadLanes(values + i, loaded);
+                step(loaded);
+            }
+
+            if (i < count)
+            {
+                T padded[lanes]{};
+                std::copy(values + i, values + count, padded);
+                loadLanes(padded, loaded);
+                step(loaded);
+            }
+        }
+
+        // Adds values[0..count) pairwise, in place: neighbours first, then neighbouring sums, and so on.
+        double addPairwise(double* values, std::size_t count)
+        {
+            if (count == 0)
+                return 0.0;
+
+            for (; count > 1; count = (count + 1) / 2)
+            {
+                for (std::size_t i{ 0 }; i < count / 2; ++i)
+                    values[i] = values[2 * i] + values[2 * i + 1];
+
+                if (count % 2 != 0)
+                    values[count / 2] = values[count - 1];
+            }
+
+            return values[0];
+        }
+
+        double addLanes(const Lanes& sums)
+        {
+            double partial[lanes];
+            std::memcpy(partial, sums.vectors, sizeof(partial));
+            return addPairwise(partial, lanes);
+        }
+
+        // Blocks of pairwiseBlock values summed in the lanes, and then the lanes and the blocks' sums pairwise.
+        template <typename T>
+        SUMMATION_KERNEL
+        double sumPairwise(const T* values, std::size_t count)
+        {
+            double blockSums[chunkSize / pairwiseBlock];
+            std::size_t blocks{ 0 };
+
+            for (std::size_t first{ 0 }; first < count; first += pairwiseBlock)
+            {
+                Lanes sums{};
+                forEachLanes(values + first, std::min(pairwiseBlock, count - first), [&](const Lanes& x)
+                {
+                    for (std::size_t v{ 0 }; v < vectorCount; ++v)
+                        sums.vectors[v] += x.vectors[v];
+                });
+
+                blockSums[blocks++] = addLanes(sums);
+            }
+
+            return addPairwise(blockSums, blocks);
+        }
+
+        struct Compensated
+        {
+            double sum{ 0.0 };
+            double compensation{ 0.0 };
+        };
+
+        // Neumaier's improvement on Kahan: the compensation collects the exact rounding error of every addition. Neumaier finds it
+        // by checking which of sum and value is larger; Knuth's TwoSum, used here, gets the same error without asking, in a few more
+        // additions but no branch, which is what lets the lanes go side by side in SIMD registers. For a double, and for a vector of them.
+        template <typename Number>
+        void addCompensated(Number& sum, Number& compensation, const Number& value)
+        {
+            Number total{ sum + value };
+            Number valuePart{ total - sum };
+            compensation += (sum - (total - valuePart)) + (value - valuePart);
+            sum = total;
+        }
+
+        template <typename T>
+        SUMMATION_KERNEL
+        Compensated sumCompensated(const T* values, std::size_t count)
+        {
+            Lanes sums{};
+            Lanes compensations{};
+            forEachLanes(values, count, [&](const Lanes& x)
+            {
+                for (std::size_t v{ 0 }; v < vectorCount; ++v)
+                    addCompensated(sums.vectors[v], compensations.vectors[v], x.vectors[v]);
+            });
+
+            double laneSums[lanes];
+            double laneCompensations[lanes];
+            std::memcpy(laneSums, sums.vectors, sizeof(laneSums));
+            std::memcpy(laneCompensations, compensations.vectors, sizeof(laneCompensations));
+
+            Compensated total{};
+            for (std::size_t lane{ 0 }; lane < lanes; ++lane)
+            {
+                addCompensated(total.sum, total.compensation, laneSums[lane]);
+                total.compensation += laneCompensations[lane];
+            }
+
+            return total;
+        }
+
+        // A fixed-point number wide enough for any sum of doubles, exactly: one bit for every power of two from the smallest subnormal,
+        // 2^-1074, to past the largest double, in 32-bit digits. Each digit is kept in an int64_t, so that about a billion additions
+        // can go in before the carries have to be passed on.
+        class ExactAccumulator
+        {
+        public:
+            void add(double value)
+            {
+                std::uint64_t bits{ std::bit_cast<std::uint64_t>(value) };
+                unsigned exponent{ static_cast<unsigned>(bits >> 52) & 0x7ff };
+                std::uint64_t mantissa{ bits & mantissaMask };
+                bool negative{ (bits >> 63) != 0 };
+
+                if (exponent == 0x7ff)
+                {
+                    if (mantissa != 0)
+                        m_nan = true;
+                    else if (negative)
+                        m_negativeInfinity = true;
+                    else
+                        m_positiveInfinity = true;
+
+                    return;
+                }
+
+                // The value is mantissa * 2^position in units of 2^-1074. Subnormals have no implicit leading 1, but the same position as
+                // the smallest normal numbers.
+                unsigned position{ 0 };
+                if (exponent != 0)
+                {
+                    mantissa |= std::uint64_t{ 1 } << 52;
+                    position = exponent - 1;
+                }
+
+                unsigned __int128 shifted{ static_cast<unsigned __int128>(mantissa) << (position % 32) };
+                std::int64_t* digit{ m_digits + position / 32 };
+                std::int64_t parts[]{ static_cast<std::int64_t>(shifted & digitMask), static_cast<std::int64_t>((shifted >> 32) & digitMask), static_cast<std::int64_t>(shifted >> 64) };
+                for (std::size_t i{ 0 }; i < 3; ++i)
+                    digit[i] += negative ? -parts[i] : parts[i];
+
+                countAddition(1);
+            }
+
+            void add(const ExactAccumulator& other)
+            {
+                for (std::size_t i{ 0 }; i < digitCount; ++i)
+                    m_digits[i] += other.m_digits[i];
+
+                m_nan |= other.m_nan;
+                m_positiveInfinity |= other.m_positiveInfinity;
+                m_negativeInfinity |= other.m_negativeInfinity;
+                countAddition(other.m_additions + 1);
+            }
+
+            // The sum, rounded to the nearest double (a tie to the even one).
+            double round() const
+            {
+                if (m_nan || (m_positiveInfinity && m_negativeInfinity))
+                    return std::numeric_limits<double>::quiet_NaN();
+                if (m_positiveInfinity || m_negativeInfinity)
+                    return m_positiveInfinity ? std::numeric_limits<double>::infinity() : -std::numeric_limits<double>::infinity();
+
+                ExactAccumulator magnitude{ *this };
+                magnitude.carry();
+
+                // Only the top digit can be negative after the carries. A negative sum is rounded as its magnitude, which rounds the same.
+                bool negative{ magnitude.m_digits[digitCount - 1] < 0 };
+                if (negative)
+                {
+                    for (std::int64_t& digit : magnitude.m_digits)
+                        digit = -digit;
+
+                    magnitude.carry();
+                }
+
+                std::size_t top{ digitCount };
+                while (top > 0 && magnitude.m_digits[top - 1] == 0)
+                    --top;
+
+                if (top == 0)
+                    return 0.0;
+
+                // The top three digits (those below the first counting as 0) hold the leading 53 bits and the next, deciding, ones.
+                // Anything below them only matters to break what would otherwise be a tie.
+                std::size_t high{ top - 1 };
+                auto digitAt{ [&](std::size_t index) { return index < digitCount ? static_cast<std::uint64_t>(magnitude.m_digits[index]) : std::uint64_t{ 0 }; } };
+                unsigned __int128 window{ (static_cast<unsigned __int128>(digitAt(high)) << 64) | (static_cast<unsigned __int128>(digitAt(high - 1)) << 32) | digitAt(high - 2) };
+
+                bool sticky{ false };
+                for (std::size_t i{ 0 }; i + 2 < high; ++i)
+                    sticky |= magnitude.m_digits[i] != 0;
+
+                int leading{ 64 + 63 - std::countl_zero(digitAt(high)) };
+                int shift{ leading - 52 };
+                unsigned __int128 mantissa{ window >> shift };
+                unsigned __int128 rest{ window & ((static_cast<unsigned __int128>(1) << shift) - 1) };
+                unsigned __int128 half{ static_cast<unsigned __int128>(1) << (shift - 1) };
+                if (rest > half || (rest == half && (sticky || (mantissa & 1) != 0)))
+                    ++mantissa;
+
+                // ldexp() is exact here, or overflows to infinity when the rounded sum is past the largest double, as it should.
+                int exponent{ (static_cast<int>(high) - 2) * 32 + shift - 1074 };
+                double result{ std::ldexp(static_cast<double>(static_cast<std::uint64_t>(mantissa)), exponent) };
+                return negative ? -result : result;
+            }
+
+        private:
+            static constexpr std::uint64_t mantissaMask{ (std::uint64_t{ 1 } << 52) - 1 };
+            static constexpr std::uint64_t digitMask{ 0xffffffff };
+
+            // Bits 0 to 2098 for the doubles themselves, and 64 more for the sum to grow into.
+            static constexpr std::size_t digitCount{ 68 };
+
+            // Leaves every digit but the top one in [0, 2^32).
+            void carry()
+            {
+                for (std::size_t i{ 0 }; i + 1 < digitCount; ++i)
+                {
+                    m_digits[i + 1] += m_digits[i] >> 32;
+                    m_digits[i] &= static_cast<std::int64_t>(digitMask);
+                }
+
+                m_additions = 0;
+            }
+
+            void countAddition(std::uint64_t additions)
+            {
+                m_additions += additions;
+                if (m_additions >= (std::uint64_t{ 1 } << 30))
+                    carry();
+            }
+
+            std::int64_t m_digits[digitCount]{};
+            std::uint64_t m_additions{ 0 };
+            bool m_nan{ false };
+            bool m_positiveInfinity{ false };
+            bool m_negativeInfinity{ false };
+        };
+
+        // The sum of the magnitudes of everything added, in lanes like the other sums. It bounds the largest of them, and whatever
+        // the high parts below add up to, with only and and add instructions (SSE2 has no vector maximum for a ?: to become);
+        // and it is infinity or NaN as soon as one of the values is.
+        struct MagnitudeSum
+        {
+            Vector sums[vectorCount]{};
+
+            void add(const Lanes& x)
+            {
+                // Casting between vectors of the same size keeps the bits, like std::bit_cast: this clears the signs.
+                for (std::size_t v{ 0 }; v < vectorCount; ++v)
+                    sums[v] += (Vector)((BitVector)x.vectors[v] & std::numeric_limits<std::int64_t>::max());
+            }
+
+            double total() const
+            {
+                double total{ 0.0 };
+                for (std::size_t v{ 0 }; v < vectorCount; ++v)
+                {
+                    for (std::size_t i{ 0 }; i < vectorSize; ++i)
+                        total += sums[v][i];
+                }
+
+                return total;
+            }
+        };
+
+        // Copies values[0..count) to residuals as doubles, padded with zeros to whole lanes, and returns the sum of their magnitudes.
+        template <typename T>
+        SUMMATION_KERNEL
+        double loadExactBlock(const T* values, std::size_t count, double* residuals)
+        {
+            MagnitudeSum magnitude{};
+            forEachLanes(values, count, [&](const Lanes& x)
+            {
+                storeLanes(x, residuals);
+                residuals += lanes;
+                magnitude.add(x);
+            });
+
+            return magnitude.total();
+        }
+
+        // Splits every residual r into the part that is a multiple of ulp(sigma), which (sigma + r) - sigma gives exactly
+        // for a power of two sigma at least |r|, and what is left below it (Rump, Ogita and Oishi's ExtractScalar).
+        // sigma is chosen so that the high parts all add up without rounding, in any order. Returns their exact sum,
+        // and the sum of the magnitudes of what is left in the way loadExactBlock() does. count is a whole number of lanes.
+        SUMMATION_KERNEL
+        double extractHighParts(double* residuals, std::size_t count, double sigma, double& residualMagnitude)
+        {
+            Lanes high{};
+            MagnitudeSum magnitude{};
+
+            for (std::size_t i{ 0 }; i < count; i += lanes)
+            {
+                Lanes x;
+                loadLanes(residuals + i, x);
+                for (std::size_t v{ 0 }; v < vectorCount; ++v)
+                {
+                    Vector part{ (sigma + x.vectors[v]) - sigma };
+                    x.vectors[v] -= part;
+                    high.vectors[v] += part;
+                }
+
+                storeLanes(x, residuals + i);
+                magnitude.add(x);
+            }
+
+            residualMagnitude = magnitude.total();
+            return addLanes(high);
+        }
+
+        // Every pass takes about 40 more bits off every value, so a block of doubles of similar size takes two or three.
+        template <typename T>
+        void sumExact(const T* values, std::size_t count, ExactAccumulator& accumulator)
+        {
+            double residuals[exactBlock];
+
+            for (std::size_t first{ 0 }; first < count; first += exactBlock)
+            {
+                std::size_t size{ std::min(exactBlock, count - first) };
+                double magnitude{ loadExactBlock(values + first, size, residuals) };
+                size = (size + lanes - 1) / lanes * lanes;
+
+                while (magnitude != 0.0)
+                {
+                    // With the magnitudes adding up to less than 2^(e + 1), so do the high parts, give or take an ulp(sigma) each,
+                    // and every partial sum of them fits under 2 * sigma = 2^(e + 3), where it is a whole number of ulp(sigma).
+                    // (ilogb() gives e for subnormals too.) Once sigma is below 2^-1022, its ulp is the smallest subnormal and the high parts are all that is left.
+                    int exponent{ std::isfinite(magnitude) ? std::ilogb(magnitude) + 2 : std::numeric_limits<int>::max() };
+                    if (exponent > std::numeric_limits<double>::max_exponent - 1)
+                    {
+                        // Infinity or NaN, or numbers so big that sigma would overflow: one at a time, straight into the accumulator,
+                        // which keeps track of infinities and NaN.
+                        for (std::size_t i{ 0 }; i < size; ++i)
+                            accumulator.add(residuals[i]);
+
+                        break;
+                    }
+
+                    double sigma{ std::ldexp(1.0, exponent) };
+                    accumulator.add(extractHighParts(residuals, size, sigma, magnitude));
+                }
+            }
+        }
+
+        // Runs work(chunk) for every chunk, each thread taking one contiguous run of them. The main thread takes the first run itself.
+        template <typename Work>
+        void forEachChunk(std::size_t chunks, unsigned threads, Work work)
+        {
+            // Asking the system takes microseconds, as long as summing a few thousand values: once is enough.
+            static const unsigned cores{ std::max(1u, std::thread::hardware_concurrency()) };
+            if (threads == 0)
+                threads = cores;
+
+            std::size_t chunksPerThread{ std::max<std::size_t>(1, (chunks + threads - 1) / threads) };
+            auto runChunks{ [&work](std::size_t first, std::size_t last)
+            {
+                for (std::size_t chunk{ first }; chunk < last; ++chunk)
+                    work(chunk);
+            } };
+
+            std::vector<std::thread> workers{};
+            for (std::size_t first{ chunksPerThread }; first < chunks; first += chunksPerThread)
+                workers.emplace_back(runChunks, first, std::min(chunks, first + chunksPerThread));
+
+            runChunks(0, std::min(chunks, chunksPerThread));
+
+            for (std::thread& worker : workers)
+                worker.join();
+        }
+
+        template <typename T>
+        double sumValues(const T* values, std::size_t count, Summation method, unsigned threads)
+        {
+            std::size_t chunks{ (count + chunkSize - 1) / chunkSize };
+            auto chunkValues{ [&](std::size_t chunk) { return values + chunk * chunkSize; } };
+            auto chunkCount{ [&](std::size_t chunk) { return std::min(chunkSize, count - chunk * chunkSize); } };
+
+            switch (method)
+            {
+            case Summation::pairwise:
+            {
+                // The chunks' sums are combined pairwise too, so that the whole column is one pairwise sum.
+                std::vector<double> partials(chunks);
+                forEachChunk(chunks, threads, [&](std::size_t chunk) { partials[chunk] = sumPairwise(chunkValues(chunk), chunkCount(chunk)); });
+                return addPairwise(partials.data(), chunks);
+            }
+            case Summation::compensated:
+            {
+                std::vector<Compensated> partials(chunks);
+                forEachChunk(chunks, threads, [&](std::size_t chunk) { partials[chunk] = sumCompensated(chunkValues(chunk), chunkCount(chunk)); });
+
+                Compensated total{};
+                for (const Compensated& partial : partials)
+                {
+                    addCompensated(total.sum, total.compensation, partial.sum);
+                    total.compensation += partial.compensation;
+                }
+
+                // An infinity (or an overflow) turns the compensation into NaN, inf - inf, where the plain sum is right.
+                return std::isfinite(total.sum) ? total.sum + total.compensation : total.sum;
+            }
+            case Summation::exact:
+            {
+                std::vector<ExactAccumulator> partials(chunks);
+                forEachChunk(chunks, threads, [&](std::size_t chunk) { sumExact(chunkValues(chunk), chunkCount(chunk), partials[chunk]); });
+
+                ExactAccumulator total{};
+                for (const ExactAccumulator& partial : partials)
+                    total.add(partial);
+
+                return total.round();
+            }
+            }
+
+            return 0.0;
+        }
+    }
+
+    double sum(const double* values, std::size_t count, Summation method, unsigned threads)
+    {
+        return sumValues(values, count, method, threads);
+    }
+
+    double sum(const float* values, std::size_t count, Summation method, unsigned threads)
+    {
+        return sumValues(values, count, method, threads);
+    }
+}
@@ -0,0 +1,27 @@
+#ifndef SUMMATION_H
+#define SUMMATION_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace calculator
+{
+    // How sum() adds a long column of floating point numbers. Adding them one after the other, as a loop would, rounds after every
+    // addition, and the errors grow with the length of the column: a million floats summed in a float can be off in the third digit
+    // (lesson 4.8 shows how few digits a float has to begin with). Each of these is both more accurate and, being vectorized, faster.
+    enum class Summation : std::uint8_t
+    {
+        pairwise,    // Halves, summed separately and then added, down to blocks of 256: the error grows with log(n) instead of n.
+        compensated, // Kahan-Babuska (Neumaier): a second sum collects what every addition rounded away. As good as long double, or better.
+        exact,       // The exact sum, rounded once. Cancellation ("1e100 + 1 - 1e100") does not lose anything.
+    };
+
+    // The sum of values[0..count), as a double (floats are added in double precision), spread over threads cores (0 means all of them).
+    // The result is the same, to the last bit, for every number of threads and on every CPU: the column is always cut into the same chunks,
+    // each chunk is summed in a fixed pattern of partial sums, whatever the SIMD width, and the chunks' sums are combined in order.
+    // A NaN, or infinities of both signs, give NaN.
+    double sum(const double* values, std::size_t count, Summation method = Summation::compensated, unsigned threads = 0);
+    double sum(const float* values, std::size_t count, Summation method = Summation::compensated, unsigned threads = 0);
+}
+
+#endif
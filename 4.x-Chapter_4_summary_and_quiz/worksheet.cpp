@@ -0,0 +1,188 @@
+#include "worksheet.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace calculator
+{
+    std::size_t Worksheet::cellIndex(std::string_view name)
+    {
+        auto found{ m_index.find(name) };
+        if (found != m_index.end())
+            return found->second;
+
+        Cell cell{};
+        cell.name = name;
+        cell.value = std::numeric_limits<double>::quiet_NaN();
+
+        m_cells.push_back(std::move(cell));
+        m_visited.push_back(0);
+        m_index.emplace(std::string{ name }, m_cells.size() - 1);
+        return m_cells.size() - 1;
+    }
+
+    // True if any of targets is from itself or downstream of it.
+    bool Worksheet::reaches(std::size_t from, const std::vector<std::size_t>& targets)
+    {
+        ++m_walk;
+        m_stack.assign(1, from);
+        m_visited[from] = m_walk;
+
+        while (!m_stack.empty())
+        {
+            std::size_t index{ m_stack.back() };
+            m_stack.pop_back();
+
+            if (std::find(targets.begin(), targets.end(), index) != targets.end())
+                return true;
+
+            for (std::size_t dependent : m_cells[index].dependents)
+            {
+                if (m_visited[dependent] != m_walk)
+                {
+                    m_visited[dependent] = m_walk;
+                    m_stack.push_back(dependent);
+                }
+            }
+        }
+
+        return false;
+    }
+
+    // Marks index and everything downstream of it dirty. A cell that is already dirty has dirty dependents too
+    // (a cell is only recomputed after everything it uses), so the walk stops there.
+    void Worksheet::markDirty(std::size_t index)
+    {
+        m_stack.assign(1, index);
+
+        while (!m_stack.empty())
+        {
+            Cell& cell{ m_cells[m_stack.back()] };
+            m_stack.pop_back();
+
+            if (cell.dirty)
+                continue;
+
+            cell.dirty = true;
+            m_stack.insert(m_stack.end(), cell.dependents.begin(), cell.dependents.end());
+        }
+    }
+
+    void Worksheet::compute(Cell& cell)
+    {
+        m_values.resize(cell.inputs.size());
+        for (std::size_t i{ 0 }; i < cell.inputs.size(); ++i)
+            m_values[i] = m_cells[cell.inputs[i]].value;
+
+        cell.value = cell.program.evaluate(m_values.data(), cell.registers.data());
+        cell.dirty = false;
+        ++m_evaluations;
+    }
+
+    // Brings index up to date: its dirty inputs are computed first, then it. Clean cells are left alone.
+    double Worksheet::recompute(std::size_t index)
+    {
+        m_stack.assign(1, index);
+
+        while (!m_stack.empty())
+        {
+            Cell& cell{ m_cells[m_stack.back()] };
+            if (!cell.dirty)
+            {
+                m_stack.pop_back();
+                continue;
+            }
+
+            bool ready{ true };
+            for (std::size_t input : cell.inputs)
+            {
+                if (m_cells[input].dirty)
+                {
+                    m_stack.push_back(input);
+                    ready = false;
+                }
+            }
+
+            if (ready)
+            {
+                compute(cell);
+                m_stack.pop_back();
+            }
+        }
+
+        return m_cells[index].value;
+    }
+
+    bool Worksheet::define(std::string_view name, std::string_view expression, CompileError& error)
+    {
+        Program program{};
+        if (!compile(expression, program, error))
+            return false;
+
+        std::size_t index{ cellIndex(name) };
+
+        std::vector<std::size_t> inputs{};
+        for (const std::string& variable : program.variables())
+            inputs.push_back(cellIndex(variable));
+
+        if (reaches(index, inputs))
+        {
+            error.message = "A cell can not use itself, directly or through other cells";
+            error.position = 0;
+            return false;
+        }
+
+        for (std::size_t input : m_cells[index].inputs)
+        {
+            std::vector<std::size_t>& dependents{ m_cells[input].dependents };
+            dependents.erase(std::find(dependents.begin(), dependents.end(), index));
+        }
+
+        for (std::size_t input : inputs)
+            m_cells[input].dependents.push_back(index);
+
+        Cell& cell{ m_cells[index] };
+        cell.registers = program.initialRegisters();
+        cell.program = std::move(program);
+        cell.inputs = std::move(inputs);
+        cell.defined = true;
+
+        markDirty(index);
+        return true;
+    }
+
+    double Worksheet::value(std::string_view name)
+    {
+        auto found{ m_index.find(name) };
+        if (found == m_index.end())
+            return std::numeric_limits<double>::quiet_NaN();
+
+        return recompute(found->second);
+    }
+
+    bool Worksheet::evaluate(std::string_view expression, double& result, CompileError& error)
+    {
+        Program program{};
+        if (!compile(expression, program, error))
+            return false;
+
+        std::vector<double> values{};
+        for (const std::string& variable : program.variables())
+            values.push_back(value(variable));
+
+        std::vector<double> registers{ program.initialRegisters() };
+        result = program.evaluate(values.data(), registers.data());
+        return true;
+    }
+
+    bool Worksheet::isDefined(std::string_view name) const
+    {
+        auto found{ m_index.find(name) };
+        return found != m_index.end() && m_cells[found->second].defined;
+    }
+}
@@ -0,0 +1,65 @@
+#ifndef WORKSHEET_H
+#define WORKSHEET_H
+
+#include "calculator.h"
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace calculator
+{
+    // Named cells whose definitions can use other cells, like a spreadsheet: after "price = 4" and "total = price * count", total follows price.
+    // Redefining a cell only marks the cells downstream of it as dirty; a dirty cell is recomputed (after the dirty cells it uses) when its value is asked for.
+    // So a change costs time proportional to the cells it actually affects, not to the whole sheet.
+    class Worksheet
+    {
+    public:
+        // Defines or redefines the cell name. Cells the expression uses that have not been defined yet are created empty.
+        // Returns false (and describes the problem in error) if the expression is not valid, or would make the cell depend on itself.
+        bool define(std::string_view name, std::string_view expression, CompileError& error);
+
+        // Returns the current value of the cell name, recomputing it first if it is dirty. Empty cells, and cells that use them, are NaN.
+        double value(std::string_view name);
+
+        // Evaluates expression against the current cells, without defining anything.
+        bool evaluate(std::string_view expression, double& result, CompileError& error);
+
+        bool isDefined(std::string_view name) const;
+
+        // How many times a cell's expression has been evaluated, in total.
+        std::size_t evaluations() const { return m_evaluations; }
+
+    private:
+        struct Cell
+        {
+            std::string name{};
+            Program program{};
+            std::vector<double> registers{};
+            std::vector<std::size_t> inputs{};     // The cells program.variables() refer to, in the same order.
+            std::vector<std::size_t> dependents{}; // Cells that have this one among their inputs.
+            double value{};
+            bool defined{ false };
+            bool dirty{ false };
+        };
+
+        std::size_t cellIndex(std::string_view name);
+        bool reaches(std::size_t from, const std::vector<std::size_t>& targets);
+        void markDirty(std::size_t index);
+        double recompute(std::size_t index);
+        void compute(Cell& cell);
+
+        std::vector<Cell> m_cells{};
+        std::map<std::string, std::size_t, std::less<>> m_index{};
+        std::vector<double> m_values{};           // Scratch: the input values of the cell being computed.
+        std::vector<std::size_t> m_stack{};       // Scratch for the graph walks, which are iterative so that long chains of cells can not overflow the call stack.
+        std::vector<unsigned> m_visited{};        // Per cell: the walk that last visited it.
+        unsigned m_walk{ 0 };
+        std::size_t m_evaluations{ 0 };
+    };
+}
+
+#endif